@@ -0,0 +1,605 @@
+#include <algorithm> //For Filling The Lane Arrays
+#include <cstring>   //For Comparing Memory Pages
+#include "BatchChip8.h"
+
+namespace
+{
+    // Rotate A Display Row Right, Used To Place A Sprite Row At A Column With Wrap Around
+    inline unsigned long long rotateRight(unsigned long long value, unsigned int amount)
+    {
+        amount &= 63u;
+        return (amount == 0u) ? value : (value >> amount) | (value << (64u - amount));
+    }
+}
+
+//Constructor
+BatchChip8::BatchChip8(size_t laneCount)
+    : lanes(laneCount),
+      registers(16 * laneCount, 0u),
+      memory(0x1000 * laneCount, 0u),
+      index(laneCount, 0u),
+      programCounter(laneCount, 0x200u),
+      stack(16 * laneCount, 0u),
+      sp(laneCount, 0u),
+      delayTimer(laneCount, 0u),
+      soundTimer(laneCount, 0u),
+      keys(laneCount, 0u),
+      keyWaitMask(laneCount, 0u),
+      waitingForKey(laneCount, 0u),
+      video(32 * laneCount, 0u),
+      pcStop(laneCount, 0x200u),
+      randomState(laneCount, 1u),
+      cycles(laneCount, 0u),
+      faults(laneCount, NoFault),
+      faultOpcode(laneCount, 0u),
+      opcodes(laneCount, 0u),
+      running(laneCount, 0u)
+{
+}
+
+// Clear Every Lane And Load The Same Program Into Each (The Font Comes From A Freshly Constructed Chip8)
+void BatchChip8::loadProgram(const unsigned char *program, size_t size)
+{
+    Chip8 blank;
+    blank.loadProgram(program, size);
+    for (size_t lane = 0; lane < lanes; lane++)
+    {
+        unsigned int seed = randomState[lane];
+        loadLane(lane, blank);
+        randomState[lane] = seed; // each lane keeps its own random seed
+    }
+}
+
+// Copy One Emulator Into A Lane
+void BatchChip8::loadLane(size_t lane, const Chip8 &emulator)
+{
+    for (int i = 0; i < 16; i++)
+    {
+        registers[i * lanes + lane] = emulator.registers[i];
+        stack[i * lanes + lane] = emulator.stack[i];
+    }
+    std::copy(emulator.memory, emulator.memory + 0x1000, memory.begin() + lane * 0x1000);
+    index[lane] = emulator.index;
+    programCounter[lane] = emulator.pc;
+    sp[lane] = emulator.sp;
+    delayTimer[lane] = emulator.delayTimer;
+    soundTimer[lane] = emulator.soundTimer;
+    pcStop[lane] = emulator.pcStop;
+    randomState[lane] = emulator.randomState;
+    cycles[lane] = emulator.cycle;
+    faults[lane] = NoFault;
+
+    keys[lane] = emulator.keypad.load();
+    keyWaitMask[lane] = emulator.keyWaitMask;
+    waitingForKey[lane] = emulator.waitingForKey ? 1u : 0u;
+
+    for (int y = 0; y < 32; y++)
+    {
+        video[y * lanes + lane] = emulator.video[y];
+    }
+}
+
+// Copy A Lane Back Out Into An Emulator
+void BatchChip8::storeLane(size_t lane, Chip8 &emulator) const
+{
+    for (int i = 0; i < 16; i++)
+    {
+        emulator.registers[i] = registers[i * lanes + lane];
+        emulator.stack[i] = stack[i * lanes + lane];
+    }
+    // Lanes Do Not Track Their Stores, So Any Page That Changed Is Noted As Written
+    const unsigned char *laneMemory = &memory[lane * 0x1000];
+    for (unsigned int page = 0; page < Chip8::PAGE_COUNT; page++)
+    {
+        if (std::memcmp(laneMemory + page * Chip8::PAGE_SIZE, emulator.memory + page * Chip8::PAGE_SIZE, Chip8::PAGE_SIZE) != 0)
+        {
+            emulator.markWritten(page * Chip8::PAGE_SIZE, 1);
+        }
+    }
+    std::copy(laneMemory, laneMemory + 0x1000, emulator.memory);
+    emulator.index = index[lane];
+    emulator.pc = programCounter[lane];
+    emulator.sp = sp[lane];
+    // Lanes Do Not Keep Performance Counters, So The Timers Are Noted As Set To Whatever The Lane Left In Them
+    emulator.counters.setDelay(emulator.delayTimer, delayTimer[lane]);
+    emulator.counters.setSound(emulator.soundTimer, soundTimer[lane]);
+    emulator.delayTimer = delayTimer[lane];
+    emulator.soundTimer = soundTimer[lane];
+    emulator.pcStop = pcStop[lane];
+    emulator.randomState = randomState[lane];
+    emulator.cycle = cycles[lane];
+    emulator.opcode = opcodes[lane];
+    emulator.setKeys(keys[lane]);
+    emulator.keyWaitMask = keyWaitMask[lane];
+    emulator.waitingForKey = waitingForKey[lane] != 0u;
+
+    for (int y = 0; y < 32; y++)
+    {
+        emulator.video[y] = video[y * lanes + lane];
+    }
+}
+
+// Throw The Same Exception Chip8 Would Have Thrown For A Lane That Stopped (The Lane Faults Match Chip8::Fault)
+void BatchChip8::raiseFault(size_t lane) const
+{
+    Chip8::raiseFault(static_cast<Chip8::Fault>(faults[lane]), faultOpcode[lane]);
+}
+
+// Execute Several Instructions In Every Running Lane
+void BatchChip8::run(unsigned long long steps)
+{
+    for (unsigned long long i = 0; i < steps; i++)
+    {
+        step();
+    }
+}
+
+// Execute One Instruction In Every Running Lane
+void BatchChip8::step()
+{
+    // Fetch One Opcode Per Lane, Stopping Lanes That Ran Out Of Instructions
+    groupKeys.clear();
+    bool lockstep = lanes > 0;
+    for (size_t lane = 0; lane < lanes; lane++)
+    {
+        running[lane] = (faults[lane] == NoFault);
+        if (running[lane] && programCounter[lane] >= pcStop[lane])
+        {
+            faults[lane] = OutOfInstructions;
+            running[lane] = 0u;
+        }
+        if (running[lane])
+        {
+            const unsigned char *laneMemory = &memory[lane * 0x1000];
+            opcodes[lane] = static_cast<unsigned short>((laneMemory[programCounter[lane]] << 8u) | laneMemory[(programCounter[lane] + 1) & 0x0FFFu]);
+            programCounter[lane] += 2;
+            groupKeys.push_back((static_cast<unsigned long long>(opcodes[lane]) << 32u) | lane);
+        }
+        lockstep = lockstep && running[lane] && opcodes[lane] == opcodes[0];
+    }
+
+    // Lanes Still In Lockstep Run As One Group Over Every Lane, Whose Loops Need No Lane List And Can Be Vectorized
+    if (lockstep)
+    {
+        execute(opcodes[0], EveryLane{lanes});
+    }
+    else
+    {
+        // Otherwise Sort The Running Lanes By Opcode Once, So Every Group Is One Run Of The Sorted Lanes And A Step Costs The Same However Far They Diverge
+        std::sort(groupKeys.begin(), groupKeys.end());
+        groupLanes.resize(groupKeys.size());
+        for (size_t i = 0; i < groupKeys.size(); i++)
+        {
+            groupLanes[i] = static_cast<unsigned int>(groupKeys[i] & 0xFFFFFFFFu);
+        }
+        for (size_t first = 0, last = 0; first < groupKeys.size(); first = last)
+        {
+            unsigned short opcode = static_cast<unsigned short>(groupKeys[first] >> 32u);
+            while (last < groupKeys.size() && (groupKeys[last] >> 32u) == opcode)
+            {
+                ++last;
+            }
+            execute(opcode, LaneList{&groupLanes[first], last - first});
+        }
+    }
+
+    // Count Down The Timers And Count The Instruction Of Every Lane That Executed Without Stopping
+    for (size_t lane = 0; lane < lanes; lane++)
+    {
+        unsigned char ticked = running[lane] & static_cast<unsigned char>(faults[lane] == NoFault);
+        delayTimer[lane] -= static_cast<unsigned char>(ticked & (delayTimer[lane] > 0));
+        soundTimer[lane] -= static_cast<unsigned char>(ticked & (soundTimer[lane] > 0));
+        cycles[lane] += ticked;
+    }
+}
+
+// Mark The Lanes In A Group As Stopped
+template <typename Group>
+void BatchChip8::stopLanes(const Group &group, LaneFault reason, unsigned short opcode)
+{
+    for (size_t i = 0; i < group.size(); i++)
+    {
+        faults[group[i]] = reason;
+        faultOpcode[group[i]] = opcode;
+    }
+}
+
+// Execute One Opcode For Every Lane In A Group, Mirroring The Chip8 Operation Functions
+template <typename Group>
+void BatchChip8::execute(unsigned short opcode, const Group &group)
+{
+    const unsigned int x = (opcode & 0x0F00u) >> 8u;
+    const unsigned int y = (opcode & 0x00F0u) >> 4u;
+    const unsigned char n = opcode & 0x000Fu;
+    const unsigned char nn = opcode & 0x00FFu;
+    const unsigned short nnn = opcode & 0x0FFFu;
+
+    unsigned char *vx = &registers[x * lanes];
+    unsigned char *vy = &registers[y * lanes];
+    unsigned char *vf = &registers[0xF * lanes];
+    unsigned short *pc = programCounter.data();
+
+    switch (opcode >> 12u)
+    {
+    case 0x0:
+        if (nnn == 0x0E0) // OP_00E0
+        {
+            for (int row = 0; row < 32; row++)
+            {
+                unsigned long long *line = &video[row * lanes];
+                for (size_t i = 0; i < group.size(); i++)
+                {
+                    size_t lane = group[i];
+                    line[lane] = 0u;
+                }
+            }
+        }
+        else if (nnn == 0x0EE) // OP_00EE
+        {
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                if (sp[lane] == 0)
+                {
+                    faults[lane] = StackUnderflow;
+                    faultOpcode[lane] = opcode;
+                    continue;
+                }
+                --sp[lane];
+                pc[lane] = stack[sp[lane] * lanes + lane];
+            }
+        }
+        else // OP_0nnn
+        {
+            stopLanes(group, UnsupportedLanguage, opcode);
+        }
+        break;
+
+    case 0x1: // OP_1nnn
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            pc[lane] = nnn;
+        }
+        break;
+
+    case 0x2: // OP_2nnn
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            if (sp[lane] >= 16)
+            {
+                faults[lane] = StackOverflow;
+                faultOpcode[lane] = opcode;
+                continue;
+            }
+            stack[sp[lane] * lanes + lane] = pc[lane];
+            ++sp[lane];
+            pc[lane] = nnn;
+        }
+        break;
+
+    case 0x3: // OP_3xnn
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            pc[lane] += (vx[lane] == nn) ? 2 : 0;
+        }
+        break;
+
+    case 0x4: // OP_4xnn
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            pc[lane] += (vx[lane] != nn) ? 2 : 0;
+        }
+        break;
+
+    case 0x5: // OP_5xy0
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            pc[lane] += (vx[lane] == vy[lane]) ? 2 : 0;
+        }
+        break;
+
+    case 0x6: // OP_6xnn
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            vx[lane] = nn;
+        }
+        break;
+
+    case 0x7: // OP_7xnn
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            vx[lane] = static_cast<unsigned char>(vx[lane] + nn);
+        }
+        break;
+
+    case 0x8:
+        switch (n)
+        {
+        case 0x0: // OP_8xy0
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                vx[lane] = vy[lane];
+            }
+            break;
+        case 0x1: // OP_8xy1
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                vx[lane] = vx[lane] | vy[lane];
+            }
+            break;
+        case 0x2: // OP_8xy2
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                vx[lane] = vx[lane] & vy[lane];
+            }
+            break;
+        case 0x3: // OP_8xy3
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                vx[lane] = vx[lane] ^ vy[lane];
+            }
+            break;
+        // The Flag Operations Write VX Before VF (And Read VY In Between For 8xy6 / 8xyE) Exactly Like Chip8, So X Or Y Being F Behaves The Same
+        case 0x4: // OP_8xy4
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                int sum = vx[lane] + vy[lane];
+                vx[lane] = static_cast<unsigned char>(sum);
+                vf[lane] = static_cast<unsigned char>(sum > 0xFF);
+            }
+            break;
+        case 0x5: // OP_8xy5
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                int difference = vx[lane] - vy[lane];
+                vx[lane] = static_cast<unsigned char>(difference);
+                vf[lane] = static_cast<unsigned char>(difference >= 0);
+            }
+            break;
+        case 0x6: // OP_8xy6
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                vf[lane] = static_cast<unsigned char>(vy[lane] & 1u);
+                vx[lane] = static_cast<unsigned char>(vy[lane] >> 1u);
+            }
+            break;
+        case 0x7: // OP_8xy7
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                int difference = vy[lane] - vx[lane];
+                vx[lane] = static_cast<unsigned char>(difference);
+                vf[lane] = static_cast<unsigned char>(difference >= 0);
+            }
+            break;
+        case 0xE: // OP_8xyE
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                vf[lane] = static_cast<unsigned char>(vy[lane] >> 7u);
+                vx[lane] = static_cast<unsigned char>(vy[lane] << 1u);
+            }
+            break;
+        default:
+            stopLanes(group, NullOperation, opcode);
+        }
+        break;
+
+    case 0x9: // OP_9xy0
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            pc[lane] += (vx[lane] != vy[lane]) ? 2 : 0;
+        }
+        break;
+
+    case 0xA: // OP_Annn
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            index[lane] = nnn;
+        }
+        break;
+
+    case 0xB: // OP_Bnnn
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            pc[lane] = static_cast<unsigned short>(nnn + registers[lane]);
+        }
+        break;
+
+    case 0xC: // OP_Cxnn (Each Lane Has Its Own Random State)
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            unsigned int state = randomState[lane];
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            randomState[lane] = state;
+            vx[lane] = static_cast<unsigned char>((state % 256) & nn);
+        }
+        break;
+
+    case 0xD: // OP_Dxyn
+        for (size_t i = 0; i < group.size(); i++)
+        {
+            size_t lane = group[i];
+            const unsigned char *laneMemory = &memory[lane * 0x1000];
+            vf[lane] = 0;
+
+            if (x != 0xF && y != 0xF)
+            {
+                // Draw Whole Sprite Rows At Once, Each Row Is Rotated Into Place So It Wraps Around The Screen
+                unsigned char collision = 0u;
+                for (unsigned int row = 0; row < n; row++)
+                {
+                    unsigned long long sprite = static_cast<unsigned long long>(laneMemory[(index[lane] + row) & 0x0FFFu]) << 56u;
+                    sprite = rotateRight(sprite, vx[lane]);
+                    unsigned long long &line = video[((vy[lane] + row) % 32) * lanes + lane];
+                    collision |= static_cast<unsigned char>((line & sprite) != 0u);
+                    line ^= sprite;
+                }
+                vf[lane] = collision;
+            }
+            else
+            {
+                // When X Or Y Is VF, Chip8 Re-reads The Position After Every Pixel (And VF Changes On A Collision), So Draw Pixel By Pixel
+                for (unsigned int row = 0; row < n; row++)
+                {
+                    unsigned char spriteData = laneMemory[(index[lane] + row) & 0x0FFFu];
+                    for (unsigned int col = 0; col < 8; col++)
+                    {
+                        unsigned int pixelValue = (spriteData >> (7 - col)) & 1u;
+                        unsigned int px = (vx[lane] + col) % 64;
+                        unsigned int py = (vy[lane] + row) % 32;
+                        unsigned long long bit = 1ull << (63 - px);
+                        unsigned long long &line = video[py * lanes + lane];
+                        if (pixelValue)
+                        {
+                            line ^= bit;
+                            if ((line & bit) == 0u)
+                            {
+                                vf[lane] = 1;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        break;
+
+    case 0xE:
+        if (n == 0x1 || n == 0xE) // OP_ExA1 and OP_Ex9E
+        {
+            bool skipIfPressed = (n == 0xE);
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                bool pressed = vx[lane] < 16 && ((keys[lane] >> vx[lane]) & 1u);
+                pc[lane] += (pressed == skipIfPressed) ? 2 : 0;
+            }
+        }
+        else
+        {
+            stopLanes(group, NullOperation, opcode);
+        }
+        break;
+
+    case 0xF:
+        switch (nn)
+        {
+        case 0x07: // OP_Fx07
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                vx[lane] = delayTimer[lane];
+            }
+            break;
+        case 0x0A: // OP_Fx0A
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                unsigned short released = keyWaitMask[lane] & ~keys[lane];
+                if (released != 0u)
+                {
+                    unsigned char key = 0u;
+                    while (((released >> key) & 1u) == 0u)
+                    {
+                        ++key;
+                    }
+                    vx[lane] = key;
+                    keyWaitMask[lane] = 0u;
+                    waitingForKey[lane] = 0u;
+                }
+                else
+                {
+                    keyWaitMask[lane] |= keys[lane];
+                    waitingForKey[lane] = 1u;
+                    pc[lane] -= 2;
+                }
+            }
+            break;
+        case 0x15: // OP_Fx15
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                delayTimer[lane] = vx[lane];
+            }
+            break;
+        case 0x18: // OP_Fx18
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                soundTimer[lane] = vx[lane];
+            }
+            break;
+        case 0x1E: // OP_Fx1E
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                index[lane] = static_cast<unsigned short>(index[lane] + vx[lane]);
+            }
+            break;
+        case 0x29: // OP_Fx29
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                index[lane] = static_cast<unsigned short>(0x50 + vx[lane] * 5);
+            }
+            break;
+        case 0x33: // OP_Fx33
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                unsigned char *laneMemory = &memory[lane * 0x1000];
+                laneMemory[index[lane] & 0x0FFFu] = vx[lane] / 100;
+                laneMemory[(index[lane] + 1) & 0x0FFFu] = (vx[lane] % 100) / 10;
+                laneMemory[(index[lane] + 2) & 0x0FFFu] = vx[lane] % 10;
+            }
+            break;
+        case 0x55: // OP_Fx55
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                unsigned char *laneMemory = &memory[lane * 0x1000];
+                for (unsigned int r = 0; r <= x; r++)
+                {
+                    laneMemory[index[lane] & 0x0FFFu] = registers[r * lanes + lane];
+                    ++index[lane];
+                }
+            }
+            break;
+        case 0x65: // OP_Fx65
+            for (size_t i = 0; i < group.size(); i++)
+            {
+                size_t lane = group[i];
+                const unsigned char *laneMemory = &memory[lane * 0x1000];
+                for (unsigned int r = 0; r <= x; r++)
+                {
+                    registers[r * lanes + lane] = laneMemory[index[lane] & 0x0FFFu];
+                    ++index[lane];
+                }
+            }
+            break;
+        default:
+            stopLanes(group, NullOperation, opcode);
+        }
+        break;
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef BATCHCHIP8_H
+#define BATCHCHIP8_H
+//ensure header is only declared once
+#include <vector> //For The Lane Arrays
+#include "Chip8.h"
+
+/*
+Runs Many Emulators Of The Same Program Together, Stored As Structure Of Arrays
+Every register is an array with one entry (lane) per emulator, so V3 of every lane sits side by side in memory.
+Each step() fetches one opcode per lane, then executes the lanes in groups that share the same opcode, like the threads of a GPU warp.
+While every lane fetched the same opcode the group is every lane, and its loops run straight over the arrays so the compiler may
+auto-vectorize the simple operations (nothing here uses SIMD intrinsics, and the stack, memory, key and draw operations stay scalar per lane).
+Once lanes diverge the running lanes are sorted by opcode once per step and each group loops over its own run of lane numbers, so a
+step costs about the same however many different opcodes the lanes are on. Chip8Redo --bench --lanes K times K lanes against K Chip8s.
+*/
+class BatchChip8
+{
+public:
+    // The Reason A Lane Stopped (The Same Values As Chip8::Fault)
+    enum LaneFault : unsigned char
+    {
+        NoFault = Chip8::NoFault,
+        NullOperation = Chip8::NullOperation,             // Chip8::OP_NULL
+        UnsupportedLanguage = Chip8::UnsupportedLanguage, // Chip8::OP_0nnn
+        StackUnderflow = Chip8::StackUnderflow,           // Chip8::OP_00EE
+        StackOverflow = Chip8::StackOverflow,             // Chip8::OP_2nnn
+        OutOfInstructions = Chip8::OutOfInstructions      // Chip8::step past pcStop
+    };
+
+    // Constructor
+    explicit BatchChip8(size_t laneCount);
+
+    // Methods
+    size_t laneCount() const { return lanes; }
+    void loadProgram(const unsigned char *program, size_t size); // Clears every lane and loads the same program into each
+    void loadLane(size_t lane, const Chip8 &emulator);           // Copy one emulator into a lane
+    void storeLane(size_t lane, Chip8 &emulator) const;          // Copy a lane back out into an emulator
+    void setKeys(size_t lane, unsigned short keyMask) { keys[lane] = keyMask; }
+    void seedRandom(size_t lane, unsigned int seed) { randomState[lane] = (seed != 0u) ? seed : 0x2545F491u; }
+
+    // Execute One Instruction In Every Running Lane
+    void step();
+    // Execute Several Instructions In Every Running Lane
+    void run(unsigned long long steps);
+
+    LaneFault fault(size_t lane) const { return static_cast<LaneFault>(faults[lane]); }
+    unsigned short faultingOpcode(size_t lane) const { return faultOpcode[lane]; }
+    // Throw The Same Exception Chip8 Would Have Thrown For A Lane That Stopped
+    void raiseFault(size_t lane) const;
+
+    unsigned short pc(size_t lane) const { return programCounter[lane]; }
+    unsigned long long cycle(size_t lane) const { return cycles[lane]; }
+    unsigned long long videoRow(size_t lane, int y) const { return video[y * lanes + lane]; }
+
+private:
+    // The Lanes One Opcode Runs On: Every Lane, When They All Fetched It, Or A Run Of Lane Numbers
+    struct EveryLane
+    {
+        size_t count;
+        size_t size() const { return count; }
+        size_t operator[](size_t i) const { return i; }
+    };
+    struct LaneList
+    {
+        const unsigned int *lanes;
+        size_t count;
+        size_t size() const { return count; }
+        size_t operator[](size_t i) const { return lanes[i]; }
+    };
+
+    // Execute One Opcode For Every Lane In "group"
+    template <typename Group>
+    void execute(unsigned short opcode, const Group &group);
+    // Mark The Lanes In "group" As Stopped
+    template <typename Group>
+    void stopLanes(const Group &group, LaneFault reason, unsigned short opcode);
+
+    size_t lanes;
+
+    // Lane Arrays, Register N Of Lane L Is registers[N * lanes + L]
+    std::vector<unsigned char> registers;
+    std::vector<unsigned char> memory; // 4096 bytes per lane, memory[L * 0x1000 + address]
+    std::vector<unsigned short> index;
+    std::vector<unsigned short> programCounter;
+    std::vector<unsigned short> stack; // stack[level * lanes + L]
+    std::vector<unsigned char> sp;
+    std::vector<unsigned char> delayTimer;
+    std::vector<unsigned char> soundTimer;
+    std::vector<unsigned short> keys;
+    std::vector<unsigned short> keyWaitMask; // the keys held since a lane's OP_Fx0A wait began
+    std::vector<unsigned char> waitingForKey;
+    std::vector<unsigned long long> video; // one bit per pixel, video[y * lanes + L], the leftmost pixel in the highest bit
+    std::vector<unsigned short> pcStop;
+    std::vector<unsigned int> randomState;
+    std::vector<unsigned long long> cycles; // the instructions each lane has completed, as Chip8::cycle counts them
+    std::vector<unsigned char> faults;
+    std::vector<unsigned short> faultOpcode;
+
+    // Working Arrays For One Step
+    std::vector<unsigned short> opcodes;        // the opcode each lane fetched
+    std::vector<unsigned char> running;         // 1 if the lane was running at the start of the step
+    std::vector<unsigned long long> groupKeys;  // (opcode << 32) | lane for every running lane, sorted so lanes with one opcode sit together
+    std::vector<unsigned int> groupLanes;       // the lane numbers in that order
+};
+
+#endif // BATCHCHIP8_H
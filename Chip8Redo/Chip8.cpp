@@ -13,6 +13,8 @@ Form The Framework For The Next Series Of Chip-8 Prototype Emulators To Be Built
 #include <iomanip>   //For Editing Stream Data
 #include <string>    //For Exception Messages and Dialog Messages
 #include <sstream>   //For Conveting OpCode To Hex Values When Output
+#include <cstdio>    //For Formatting Disassembled Instructions
+#include <cstring>   //For Copying Save States
 #include "Chip8.h"   //For importing in the rest of the class
 
 
@@ -47,15 +49,12 @@ void setAllValues(unsigned short *vector, unsigned short value)
     }
 }
 
-// Function to set all values in the video int array to a parameter value
-void setAllValues(unsigned int (*vector)[64], unsigned int value)
+// Function to set all rows of the video array (one 64 bit word per row) to a parameter value
+void setAllValues(unsigned long long *vector, unsigned long long value)
 {
-    for (int outer = 0; outer < 32; outer++)
+    for (int row = 0; row < 32; row++)
     {
-        for (int inner = 0; inner < 64; inner++)
-        {
-            vector[outer][inner] = value;
-        }
+        vector[row] = value;
     }
 }
 
@@ -67,6 +66,536 @@ std::string toHexString(int number)
     return ss.str();
 }
 
+// function to convert an opcode to its assembly language form (for example 0x6A02 becomes "LD VA, 0x02")
+std::string disassemble(unsigned short opcode)
+{
+    unsigned int x = (opcode & 0x0F00u) >> 8u;
+    unsigned int y = (opcode & 0x00F0u) >> 4u;
+    unsigned int n = opcode & 0x000Fu;
+    unsigned int nn = opcode & 0x00FFu;
+    unsigned int nnn = opcode & 0x0FFFu;
+    char text[32];
+
+    switch (opcode >> 12u)
+    {
+    case 0x0:
+        if (opcode == 0x00E0) return "CLS";
+        if (opcode == 0x00EE) return "RET";
+        std::snprintf(text, sizeof(text), "SYS 0x%03X", nnn);
+        return text;
+    case 0x1: std::snprintf(text, sizeof(text), "JP 0x%03X", nnn); return text;
+    case 0x2: std::snprintf(text, sizeof(text), "CALL 0x%03X", nnn); return text;
+    case 0x3: std::snprintf(text, sizeof(text), "SE V%X, 0x%02X", x, nn); return text;
+    case 0x4: std::snprintf(text, sizeof(text), "SNE V%X, 0x%02X", x, nn); return text;
+    case 0x5: std::snprintf(text, sizeof(text), "SE V%X, V%X", x, y); return text;
+    case 0x6: std::snprintf(text, sizeof(text), "LD V%X, 0x%02X", x, nn); return text;
+    case 0x7: std::snprintf(text, sizeof(text), "ADD V%X, 0x%02X", x, nn); return text;
+    case 0x8:
+    {
+        static const char *const names[16] = {"LD", "OR", "AND", "XOR", "ADD", "SUB", "SHR", "SUBN", nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, "SHL", nullptr};
+        if (names[n] == nullptr) break;
+        std::snprintf(text, sizeof(text), "%s V%X, V%X", names[n], x, y);
+        return text;
+    }
+    case 0x9: std::snprintf(text, sizeof(text), "SNE V%X, V%X", x, y); return text;
+    case 0xA: std::snprintf(text, sizeof(text), "LD I, 0x%03X", nnn); return text;
+    case 0xB: std::snprintf(text, sizeof(text), "JP V0, 0x%03X", nnn); return text;
+    case 0xC: std::snprintf(text, sizeof(text), "RND V%X, 0x%02X", x, nn); return text;
+    case 0xD: std::snprintf(text, sizeof(text), "DRW V%X, V%X, %u", x, y, n); return text;
+    case 0xE:
+        if (nn == 0x9E) { std::snprintf(text, sizeof(text), "SKP V%X", x); return text; }
+        if (nn == 0xA1) { std::snprintf(text, sizeof(text), "SKNP V%X", x); return text; }
+        break;
+    case 0xF:
+        switch (nn)
+        {
+        case 0x07: std::snprintf(text, sizeof(text), "LD V%X, DT", x); return text;
+        case 0x0A: std::snprintf(text, sizeof(text), "LD V%X, K", x); return text;
+        case 0x15: std::snprintf(text, sizeof(text), "LD DT, V%X", x); return text;
+        case 0x18: std::snprintf(text, sizeof(text), "LD ST, V%X", x); return text;
+        case 0x1E: std::snprintf(text, sizeof(text), "ADD I, V%X", x); return text;
+        case 0x29: std::snprintf(text, sizeof(text), "LD F, V%X", x); return text;
+        case 0x33: std::snprintf(text, sizeof(text), "LD B, V%X", x); return text;
+        case 0x55: std::snprintf(text, sizeof(text), "LD [I], V%X", x); return text;
+        case 0x65: std::snprintf(text, sizeof(text), "LD V%X, [I]", x); return text;
+        }
+        break;
+    }
+
+    // Anything Else Is Not An Instruction, So It Is Shown As A Data Word
+    std::snprintf(text, sizeof(text), "DW 0x%04X", opcode);
+    return text;
+}
+
+// The Message Each Fault Is Reported With
+std::string Chip8::faultMessage(Fault fault, unsigned short opcode)
+{
+    switch (fault)
+    {
+    case NullOperation:
+        return "ERROR, The Operation: " + toHexString(opcode) + " Is Unrecognized";
+    case UnsupportedLanguage:
+        return "ERROR, The Operation: " + toHexString(opcode) + " Indicates That This Program Is Dependent Upon An Nonexistent Machine Language Subroutine";
+    case StackUnderflow:
+        return "Stack underflow: Stack pointer is 0";
+    case StackOverflow:
+        return "Stack overflow: Stack pointer is 16";
+    case OutOfInstructions:
+        return "ERROR The CHIP-8 program terminated unexpectedly (Out of Instructions)";
+    default:
+        return "";
+    }
+}
+
+// Throw The Exception Each Fault Was Originally Reported With
+void Chip8::raiseFault(Fault fault, unsigned short opcode)
+{
+    switch (fault)
+    {
+    case NullOperation:
+        throw NullOperationException(faultMessage(fault, opcode));
+    case UnsupportedLanguage:
+        throw UnsupportedLanguageException(faultMessage(fault, opcode));
+    case StackUnderflow:
+    case StackOverflow:
+        throw std::runtime_error(faultMessage(fault, opcode));
+    case OutOfInstructions:
+        throw std::out_of_range(faultMessage(fault, opcode));
+    default:
+        break;
+    }
+}
+
+/*
+Instruction Dispatch For run()
+By default every instruction is decoded by the one switch at the top of the loop, so every instruction goes through the same
+indirect jump. Building with CHIP8_THREADED_DISPATCH (qmake CONFIG+=threaded_dispatch) gives every operation its own copy of the
+fetch and decode, ending in a computed goto straight to the next operation, so the branch predictor sees a separate jump for
+each operation and learns which operation tends to follow which. Computed goto is a GCC and Clang extension (MinGW included).
+The operations themselves are written once and shared by both forms.
+*/
+#if defined(CHIP8_THREADED_DISPATCH) && !defined(__GNUC__)
+#error "CHIP8_THREADED_DISPATCH needs computed goto, which only GCC and Clang support"
+#endif
+
+#define RUN_FAULT(code) \
+    {                   \
+        fault = code;   \
+        goto finished;  \
+    }
+
+// Stop At The End Of The Budget, Otherwise Read The Next Opcode And Split It Into Its Fields
+#define RUN_FETCH                                                                                                       \
+    if (executed >= cycleBudget)                                                                                        \
+    {                                                                                                                   \
+        goto finished;                                                                                                  \
+    }                                                                                                                   \
+    if (programCounter >= stop)                                                                                         \
+    {                                                                                                                   \
+        RUN_FAULT(OutOfInstructions)                                                                                    \
+    }                                                                                                                   \
+    instruction = static_cast<unsigned short>((memory[programCounter] << 8u) | memory[(programCounter + 1) & 0x0FFFu]); \
+    programCounter += 2;                                                                                                \
+    x = (instruction & 0x0F00u) >> 8u;                                                                                  \
+    y = (instruction & 0x00F0u) >> 4u;                                                                                  \
+    nn = instruction & 0x00FFu;                                                                                         \
+    nnn = instruction & 0x0FFFu;
+
+// Count Down The Timers And Count The Instruction, A Faulting Instruction Never Gets Here (As In step())
+#define RUN_RETIRE          \
+    if (delay > 0)          \
+    {                       \
+        --delay;            \
+    }                       \
+    if (sound > 0)          \
+    {                       \
+        if (soundEnabled)   \
+        {                   \
+            Beep(300, 10);  \
+        }                   \
+        --sound;            \
+    }                       \
+    ++executed;
+
+#ifdef CHIP8_THREADED_DISPATCH
+#define RUN_OPERATION(digit) operation##digit:
+#define RUN_NEXT                                \
+    {                                           \
+        RUN_RETIRE                              \
+        RUN_FETCH                               \
+        goto *operations[instruction >> 12u];   \
+    }
+#define RUN_DECODE_BEGIN \
+    RUN_FETCH            \
+    goto *operations[instruction >> 12u];
+#define RUN_DECODE_END
+#else
+#define RUN_OPERATION(digit) case digit:
+#define RUN_NEXT break;
+#define RUN_DECODE_BEGIN \
+    for (;;)             \
+    {                    \
+        RUN_FETCH        \
+        switch (instruction >> 12u)                                                                        \
+        {
+#define RUN_DECODE_END \
+        }              \
+        RUN_RETIRE     \
+    }
+#endif
+
+// How run() Dispatches Instructions In This Build
+const char *Chip8::runDispatch()
+{
+#ifdef CHIP8_THREADED_DISPATCH
+    return "threaded";
+#else
+    return "switch";
+#endif
+}
+
+// Execute Up To "cycleBudget" Instructions With The Machine State Held In Locals, Mirroring The Operation Functions In Chip8.h
+Chip8::RunResult Chip8::run(unsigned long long cycleBudget)
+{
+    unsigned short programCounter = pc;
+    unsigned short indexRegister = index;
+    unsigned char stackPointer = sp;
+    unsigned char delay = delayTimer;
+    unsigned char sound = soundTimer;
+    unsigned short instruction = opcode;
+    const unsigned short stop = pcStop;
+    const unsigned long long startCycle = cycle;
+    unsigned long long executed = 0;
+    Fault fault = NoFault;
+    unsigned int x = 0u;
+    unsigned int y = 0u;
+    unsigned char nn = 0u;
+    unsigned short nnn = 0u;
+#ifdef CHIP8_THREADED_DISPATCH
+    static const void *const operations[16] = {
+        &&operation0x0, &&operation0x1, &&operation0x2, &&operation0x3, &&operation0x4, &&operation0x5, &&operation0x6, &&operation0x7,
+        &&operation0x8, &&operation0x9, &&operation0xA, &&operation0xB, &&operation0xC, &&operation0xD, &&operation0xE, &&operation0xF};
+#endif
+
+    // Events Hand The State To The Operation Functions, Which Work On The Members, And Take Back What They Changed
+    auto writeBack = [&]()
+    {
+        pc = programCounter;
+        index = indexRegister;
+        sp = stackPointer;
+        delayTimer = delay;
+        soundTimer = sound;
+        opcode = instruction;
+        cycle = startCycle + executed;
+    };
+    auto reload = [&]()
+    {
+        programCounter = pc;
+        indexRegister = index;
+        stackPointer = sp;
+    };
+
+    RUN_DECODE_BEGIN
+    RUN_OPERATION(0x0)
+    if (nnn == 0x0E0u)
+    {
+        setAllValues(video, 0u);
+    }
+    else if (nnn == 0x0EEu)
+    {
+        if (stackPointer == 0u)
+        {
+            RUN_FAULT(StackUnderflow)
+        }
+        programCounter = stack[--stackPointer];
+    }
+    else
+    {
+        RUN_FAULT(UnsupportedLanguage)
+    }
+    RUN_NEXT
+    RUN_OPERATION(0x1)
+    programCounter = nnn;
+    RUN_NEXT
+    RUN_OPERATION(0x2)
+    if (stackPointer >= 16u)
+    {
+        RUN_FAULT(StackOverflow)
+    }
+    stack[stackPointer++] = programCounter;
+    programCounter = nnn;
+    RUN_NEXT
+    RUN_OPERATION(0x3)
+    if (registers[x] == nn)
+    {
+        programCounter += 2;
+    }
+    RUN_NEXT
+    RUN_OPERATION(0x4)
+    if (registers[x] != nn)
+    {
+        programCounter += 2;
+    }
+    RUN_NEXT
+    RUN_OPERATION(0x5)
+    // Like OP_5xy0 The Last Digit Is Not Checked
+    if (registers[x] == registers[y])
+    {
+        programCounter += 2;
+    }
+    RUN_NEXT
+    RUN_OPERATION(0x6)
+    registers[x] = nn;
+    RUN_NEXT
+    RUN_OPERATION(0x7)
+    registers[x] += nn;
+    RUN_NEXT
+    RUN_OPERATION(0x8)
+    {
+        // Each Statement Is In The Same Order As Its Operation Function, So VF Ends Up The Same When X Or Y Is F
+        int result;
+        switch (instruction & 0x000Fu)
+        {
+        case 0x0:
+            registers[x] = registers[y];
+            break;
+        case 0x1:
+            registers[x] |= registers[y];
+            break;
+        case 0x2:
+            registers[x] &= registers[y];
+            break;
+        case 0x3:
+            registers[x] ^= registers[y];
+            break;
+        case 0x4:
+            result = registers[x] + registers[y];
+            registers[x] += registers[y];
+            registers[0xF] = (result > 0xFF) ? 0x01u : 0x00u;
+            break;
+        case 0x5:
+            result = registers[x] - registers[y];
+            registers[x] -= registers[y];
+            registers[0xF] = (result < 0) ? 0x00u : 0x01u;
+            break;
+        case 0x6:
+            registers[0xF] = registers[y] & 1u;
+            registers[x] = registers[y] >> 1u;
+            break;
+        case 0x7:
+            result = registers[y] - registers[x];
+            registers[x] = registers[y] - registers[x];
+            registers[0xF] = (result < 0) ? 0x00u : 0x01u;
+            break;
+        case 0xE:
+            registers[0xF] = registers[y] >> 7u;
+            registers[x] = registers[y] << 1u;
+            break;
+        default:
+            RUN_FAULT(NullOperation)
+        }
+    }
+    RUN_NEXT
+    RUN_OPERATION(0x9)
+    if (registers[x] != registers[y])
+    {
+        programCounter += 2;
+    }
+    RUN_NEXT
+    RUN_OPERATION(0xA)
+    indexRegister = nnn;
+    RUN_NEXT
+    RUN_OPERATION(0xB)
+    programCounter = static_cast<unsigned short>(nnn + registers[0]);
+    RUN_NEXT
+    RUN_OPERATION(0xC)
+    registers[x] = static_cast<unsigned char>(getRandom() & nn);
+    RUN_NEXT
+    RUN_OPERATION(0xD)
+    // Drawing Is An Event, OP_Dxyn Reads The Index And Hands The Program Counter And Cycle To The Watchpoints
+    writeBack();
+    OP_Dxyn();
+    RUN_NEXT
+    RUN_OPERATION(0xE)
+    // Like TableE Only The Last Digit Picks The Instruction
+    if ((instruction & 0x000Fu) != 0x1u && (instruction & 0x000Fu) != 0xEu)
+    {
+        RUN_FAULT(NullOperation)
+    }
+    if (inputLatency != nullptr)
+    {
+        inputLatency->observed();
+    }
+    if ((registers[x] <= 0xF && keypad.pressed(registers[x])) == ((instruction & 0x000Fu) == 0xEu))
+    {
+        programCounter += 2;
+    }
+    RUN_NEXT
+    RUN_OPERATION(0xF)
+    switch (nn)
+    {
+    case 0x07:
+        registers[x] = delay;
+        break;
+    case 0x0A:
+        writeBack();
+        OP_Fx0A();
+        reload();
+        break;
+    case 0x15:
+        counters.setDelay(delay, registers[x]);
+        delay = registers[x];
+        break;
+    case 0x18:
+        counters.setSound(sound, registers[x]);
+        sound = registers[x];
+        break;
+    case 0x1E:
+        indexRegister += registers[x];
+        break;
+    case 0x29:
+        indexRegister = static_cast<unsigned short>(FONTSET_START_ADDRESS + registers[x] * 5);
+        break;
+    case 0x33:
+        if (watchpoints != nullptr)
+        {
+            writeBack();
+            OP_Fx33();
+            break;
+        }
+        markWritten(indexRegister, 3);
+        memory[indexRegister & 0x0FFFu] = registers[x] / 100;
+        memory[(indexRegister + 1) & 0x0FFFu] = (registers[x] % 100) / 10;
+        memory[(indexRegister + 2) & 0x0FFFu] = registers[x] % 10;
+        break;
+    case 0x55:
+        if (watchpoints != nullptr)
+        {
+            writeBack();
+            OP_Fx55();
+            reload();
+            break;
+        }
+        markWritten(indexRegister, x + 1u);
+        for (unsigned int i = 0; i <= x; i++)
+        {
+            memory[indexRegister++ & 0x0FFFu] = registers[i];
+        }
+        break;
+    case 0x65:
+        if (watchpoints != nullptr)
+        {
+            writeBack();
+            OP_Fx65();
+            reload();
+            break;
+        }
+        for (unsigned int i = 0; i <= x; i++)
+        {
+            registers[i] = memory[indexRegister++ & 0x0FFFu];
+        }
+        break;
+    default:
+        RUN_FAULT(NullOperation)
+    }
+    RUN_NEXT
+    RUN_DECODE_END
+
+finished:
+    writeBack();
+    if (fault != NoFault)
+    {
+        return faulted(fault, executed);
+    }
+    RunResult result;
+    result.executed = executed;
+    return result;
+}
+
+#undef RUN_FAULT
+#undef RUN_FETCH
+#undef RUN_RETIRE
+#undef RUN_OPERATION
+#undef RUN_NEXT
+#undef RUN_DECODE_BEGIN
+#undef RUN_DECODE_END
+
+// The Font, Loaded Into Every Emulator's Memory At FONTSET_START_ADDRESS
+const unsigned char Chip8::fontset[80] = {
+    0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
+    0x20, 0x60, 0x20, 0x20, 0x70, // 1
+    0xF0, 0x10, 0xF0, 0x80, 0xF0, // 2
+    0xF0, 0x10, 0xF0, 0x10, 0xF0, // 3
+    0x90, 0x90, 0xF0, 0x10, 0x10, // 4
+    0xF0, 0x80, 0xF0, 0x10, 0xF0, // 5
+    0xF0, 0x80, 0xF0, 0x90, 0xF0, // 6
+    0xF0, 0x10, 0x20, 0x40, 0x40, // 7
+    0xF0, 0x90, 0xF0, 0x90, 0xF0, // 8
+    0xF0, 0x90, 0xF0, 0x10, 0xF0, // 9
+    0xF0, 0x90, 0xF0, 0x90, 0x90, // A
+    0xE0, 0x90, 0xE0, 0x90, 0xE0, // B
+    0xF0, 0x80, 0x80, 0x80, 0xF0, // C
+    0xE0, 0x90, 0x90, 0x90, 0xE0, // D
+    0xF0, 0x80, 0xF0, 0x80, 0xF0, // E
+    0xF0, 0x80, 0xF0, 0x80, 0x80  // F
+};
+
+// The Function Tables Shared By Every Emulator
+const Chip8::Chip8Table Chip8::MASTER_TABLE[16] = {
+    &Chip8::Table0,
+    &Chip8::OP_1nnn,
+    &Chip8::OP_2nnn,
+    &Chip8::OP_3xnn,
+    &Chip8::OP_4xnn,
+    &Chip8::OP_5xy0,
+    &Chip8::OP_6xnn,
+    &Chip8::OP_7xnn,
+    &Chip8::Table8,
+    &Chip8::OP_9xy0,
+    &Chip8::OP_Annn,
+    &Chip8::OP_Bnnn,
+    &Chip8::OP_Cxnn,
+    &Chip8::OP_Dxyn,
+    &Chip8::TableE,
+    &Chip8::TableF};
+
+// Sub Table 0 (This Table Has A Different Structure Than ALL OTHER SUB TABLES, Table0() Picks The Entry From The Whole Opcode)
+const Chip8::Chip8Table Chip8::subTable0[3] = {&Chip8::OP_00E0, &Chip8::OP_00EE, &Chip8::OP_0nnn};
+
+// Sub Table 8 (Indexed By The Last Digit)
+const Chip8::Chip8Table Chip8::subTable8[16] = {
+    &Chip8::OP_8xy0, &Chip8::OP_8xy1, &Chip8::OP_8xy2, &Chip8::OP_8xy3,
+    &Chip8::OP_8xy4, &Chip8::OP_8xy5, &Chip8::OP_8xy6, &Chip8::OP_8xy7,
+    &Chip8::OP_NULL, &Chip8::OP_NULL, &Chip8::OP_NULL, &Chip8::OP_NULL,
+    &Chip8::OP_NULL, &Chip8::OP_NULL, &Chip8::OP_8xyE, &Chip8::OP_NULL};
+
+// Sub Table E (Indexed By The Last Digit)
+const Chip8::Chip8Table Chip8::subTableE[16] = {
+    &Chip8::OP_NULL, &Chip8::OP_ExA1, &Chip8::OP_NULL, &Chip8::OP_NULL,
+    &Chip8::OP_NULL, &Chip8::OP_NULL, &Chip8::OP_NULL, &Chip8::OP_NULL,
+    &Chip8::OP_NULL, &Chip8::OP_NULL, &Chip8::OP_NULL, &Chip8::OP_NULL,
+    &Chip8::OP_NULL, &Chip8::OP_NULL, &Chip8::OP_Ex9E, &Chip8::OP_NULL};
+
+// Sub Table F (Indexed By The Last Two Digits, Built At Compile Time Since Most Of Its 102 Entries Are OP_NULL)
+const std::array<Chip8::Chip8Table, 102> Chip8::subTableF = []() constexpr
+{
+    std::array<Chip8Table, 102> table{};
+    for (Chip8Table &entry : table)
+    {
+        entry = &Chip8::OP_NULL;
+    }
+    table[0x07] = &Chip8::OP_Fx07;
+    table[0x0A] = &Chip8::OP_Fx0A;
+    table[0x15] = &Chip8::OP_Fx15;
+    table[0x18] = &Chip8::OP_Fx18;
+    table[0x1E] = &Chip8::OP_Fx1E;
+    table[0x29] = &Chip8::OP_Fx29;
+    table[0x33] = &Chip8::OP_Fx33;
+    table[0x55] = &Chip8::OP_Fx55;
+    table[0x65] = &Chip8::OP_Fx65;
+    return table;
+}();
+
 //Redefine Constructor
 Chip8::Chip8()
 {
@@ -74,7 +603,7 @@ Chip8::Chip8()
     setAllValues(registers, static_cast<unsigned char>(0u));
     setAllValues(memory, START_ADDRESS, static_cast<unsigned char>(0u));
     setAllValues(stack, static_cast<short>(0u));
-    setAllValues(keypad, static_cast<short>(0u));
+    keypad.store(0u);
     setAllValues(video, 0u);
 
     // set the first instruction as the next instruction to be executed
@@ -82,41 +611,32 @@ Chip8::Chip8()
     for (unsigned int i = 0; i < 80; ++i)
         // loads the font into program memory
         memory[FONTSET_START_ADDRESS + i] = fontset[i];
-    // get the first random number
-    int randomNumber = getRandom();
-
-    // Overwrite The Command Not Found Function (OP_NULL) In The Sub Tables Where The Other Functions Need To Be Inserted
-
-    // Sub Table 0 Overwrite (This Table Has A Different Structure Than ALL OTHER SUB TABLES)
-    subTable0[0] = &Chip8::OP_00E0;
-    subTable0[1] = &Chip8::OP_00EE;
-    subTable0[2] = &Chip8::OP_0nnn;
-
-    // Sub Table 8 Overwrite
-    subTable8[0x0] = &Chip8::OP_8xy0;
-    subTable8[0x1] = &Chip8::OP_8xy1;
-    subTable8[0x2] = &Chip8::OP_8xy2;
-    subTable8[0x3] = &Chip8::OP_8xy3;
-    subTable8[0x4] = &Chip8::OP_8xy4;
-    subTable8[0x5] = &Chip8::OP_8xy5;
-    subTable8[0x6] = &Chip8::OP_8xy6;
-    subTable8[0x7] = &Chip8::OP_8xy7;
-    subTable8[0xE] = &Chip8::OP_8xyE;
-
-    // Sub Table E Overwrite
-    subTableE[0x1] = &Chip8::OP_ExA1;
-    subTableE[0xE] = &Chip8::OP_00EE;
-
-    // Sub Table F Overwrite
-    subTableF[0x07] = &Chip8::OP_Fx07;
-    subTableF[0x0A] = &Chip8::OP_Fx0A;
-    subTableF[0x15] = &Chip8::OP_Fx15;
-    subTableF[0x18] = &Chip8::OP_Fx18;
-    subTableF[0x1E] = &Chip8::OP_Fx1E;
-    subTableF[0x29] = &Chip8::OP_Fx29;
-    subTableF[0x33] = &Chip8::OP_Fx33;
-    subTableF[0x55] = &Chip8::OP_Fx55;
-    subTableF[0x65] = &Chip8::OP_Fx65;
+    // seed the random number generator using the current time
+    seedRandom(static_cast<unsigned int>(time(NULL)));
+}
+
+// Copy Another Emulator's State (But Not Its Settings) Into This One
+void Chip8::copyState(const Chip8 &other)
+{
+    std::memcpy(registers, other.registers, sizeof(registers));
+    std::memcpy(stack, other.stack, sizeof(stack));
+    index = other.index;
+    pc = other.pc;
+    opcode = other.opcode;
+    pcStop = other.pcStop;
+    sp = other.sp;
+    delayTimer = other.delayTimer;
+    soundTimer = other.soundTimer;
+    std::memcpy(memory, other.memory, sizeof(memory));
+    std::memcpy(video, other.video, sizeof(video));
+    keypad = other.keypad;
+    keyWaitMask = other.keyWaitMask;
+    waitingForKey = other.waitingForKey;
+    randomState = other.randomState;
+    cycle = other.cycle;
+    writtenPages = other.writtenPages;
+    counters = other.counters;
+    pendingFault = other.pendingFault;
 }
 
 /*
@@ -8,7 +8,11 @@
 #include <iomanip>   //For Editing Stream Data
 #include <string>    //For Exception Messages and Dialog Messages
 #include <sstream>   //For Conveting OpCode To Hex Values When Output
-#include <QDebug>
+#include <atomic>    //For The Keypad Shared With The GUI Thread
+#include <array>     //For The Shared Instruction Table
+#include "Watchpoints.h"  //For Memory Watchpoints
+#include "InputLatency.h" //For Measuring Input Latency
+#include "PerformanceCounters.h" //For Counting What The Emulator Does
 
 class NullOperationException : public std::exception
 {
@@ -36,6 +40,29 @@ public:
     }
 };
 
+// The Keypad As A 16 Bit Mask (Bit N Set Means Key N Is Pressed), Safe To Update From Another Thread While The Emulator Runs
+class KeyMask
+{
+private:
+    std::atomic<unsigned short> bits;
+
+public:
+    KeyMask(unsigned short mask = 0u) : bits(mask) {}
+    // Copying An Emulator Takes A Snapshot Of Its Keys
+    KeyMask(const KeyMask &other) : bits(other.load()) {}
+    KeyMask &operator=(const KeyMask &other)
+    {
+        store(other.load());
+        return *this;
+    }
+
+    unsigned short load() const { return bits.load(std::memory_order_acquire); }
+    void store(unsigned short mask) { bits.store(mask, std::memory_order_release); }
+    void press(int key) { bits.fetch_or(static_cast<unsigned short>(1u << key), std::memory_order_acq_rel); }
+    void release(int key) { bits.fetch_and(static_cast<unsigned short>(~(1u << key)), std::memory_order_acq_rel); }
+    bool pressed(int key) const { return (load() >> key) & 1u; }
+};
+
 // Non Class Related Functions
 //  Function to set all values in an unsigned char array to a parameter value
 void setAllValues(unsigned char *vector, unsigned char value);
@@ -46,62 +73,67 @@ void setAllValues(unsigned char *vector, int startIndex, unsigned char value);
 // Function to set all values in an unsigned short array to a parameter value
 void setAllValues(unsigned short *vector, unsigned short value);
 
-// Function to set all values in the video int array to a parameter value
-void setAllValues(unsigned int (*vector)[64], unsigned int value);
+// Function to set all rows of the video array (one 64 bit word per row) to a parameter value
+void setAllValues(unsigned long long *vector, unsigned long long value);
 
 // function to convert the opcode to a hex string for output
 std::string toHexString(int number);
 
-class Chip8
+// function to convert an opcode to its assembly language form (for example 0x6A02 becomes "LD VA, 0x02")
+std::string disassemble(unsigned short opcode);
+
+class alignas(64) Chip8
 {
     // Program Constants
 
     // Chip8 Memory From 0x000 to 0x1FF is reserved to store the original Chip-8 VM therefore ROM instructions must start at 0x200
-    const unsigned int START_ADDRESS = 0x200;
+    static constexpr unsigned int START_ADDRESS = 0x200;
     // Chip8 Memory From 0x050 to 0x0A0 is reserved to store the font
-    const unsigned int FONTSET_START_ADDRESS = 0x50;
-    // Chip8 Memory Displays Its 16 Characters Using 5 Bytes Each, Therefore This Array Holds 80 Bytes
-    const unsigned fontset[80] = {
-        0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
-        0x20, 0x60, 0x20, 0x20, 0x70, // 1
-        0xF0, 0x10, 0xF0, 0x80, 0xF0, // 2
-        0xF0, 0x10, 0xF0, 0x10, 0xF0, // 3
-        0x90, 0x90, 0xF0, 0x10, 0x10, // 4
-        0xF0, 0x80, 0xF0, 0x10, 0xF0, // 5
-        0xF0, 0x80, 0xF0, 0x90, 0xF0, // 6
-        0xF0, 0x10, 0x20, 0x40, 0x40, // 7
-        0xF0, 0x90, 0xF0, 0x90, 0xF0, // 8
-        0xF0, 0x90, 0xF0, 0x10, 0xF0, // 9
-        0xF0, 0x90, 0xF0, 0x90, 0x90, // A
-        0xE0, 0x90, 0xE0, 0x90, 0xE0, // B
-        0xF0, 0x80, 0x80, 0x80, 0xF0, // C
-        0xE0, 0x90, 0x90, 0x90, 0xE0, // D
-        0xF0, 0x80, 0xF0, 0x80, 0xF0, // E
-        0xF0, 0x80, 0xF0, 0x80, 0x80  // F
-    };
+    static constexpr unsigned int FONTSET_START_ADDRESS = 0x50;
+    // Chip8 Memory Displays Its 16 Characters Using 5 Bytes Each, Therefore This Array Holds 80 Bytes (Shared By Every Emulator, See Chip8.cpp)
+    static const unsigned char fontset[80];
 
-    // Set The Values Within The Function Pointers To Intially Point To Null
+    // The Operation Functions The Tables Below Point To
     typedef void (Chip8::*Chip8Table)();
-    Chip8Table setNull(Chip8Table *table, int length)
-    {
-        for (int i = 0; i < length; i++)
-        {
-            table[i] = &Chip8::OP_NULL;
-        }
-        return *table;
-    }
 
     // Chip-8 Random Number Function
     int getRandom()
     {
-        // This seeds the random number generator using the current time
-        srand(time(NULL));
+        // Advance The Emulators Own Random Number State (xorshift32) So Copies Of The Emulator Produce The Same Sequence
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 17;
+        randomState ^= randomState << 5;
         // Generate The Random Number (0 to 255)
-        return int(rand() % 256);
+        return int(randomState % 256);
     }
 
     // Public Class Methods
 public:
+    // Why Execution Stopped Before Every Instruction Asked For Had Run
+    enum Fault : unsigned char
+    {
+        NoFault = 0,
+        NullOperation,       // OP_NULL, the opcode is unrecognised
+        UnsupportedLanguage, // OP_0nnn, the program calls a machine language subroutine
+        StackUnderflow,      // OP_00EE with nothing on the stack
+        StackOverflow,       // OP_2nnn with the stack full
+        OutOfInstructions    // the program counter reached pcStop
+    };
+
+    // What A Multi Instruction Run Did, And Where It Faulted If It Did
+    struct RunResult
+    {
+        Fault fault = NoFault;
+        unsigned short pc = 0u;           // the address of the faulting instruction (pcStop when out of instructions)
+        unsigned short opcode = 0u;       // the faulting instruction (0 when out of instructions)
+        unsigned long long executed = 0u; // how many instructions completed, skipped idle instructions included
+        bool ok() const { return fault == NoFault; }
+    };
+
+    // The Message A Fault Is Reported With, And The Exception Thrown For It Where Callers Want Exceptions (The GUI)
+    static std::string faultMessage(Fault fault, unsigned short opcode);
+    static void raiseFault(Fault fault, unsigned short opcode);
+
     // Clear The Values Currently In The Emulator
     void clearEmulator()
     {
@@ -113,10 +145,16 @@ public:
         sp = 0u;
         delayTimer = 0u;
         soundTimer = 0u;
-        setAllValues(keypad, static_cast<short>(0u));
+        keypad.store(0u);
+        keyWaitMask = 0u;
+        waitingForKey = false;
         setAllValues(video, 0u);
         opcode = 0u;
         pcStop = START_ADDRESS; // program stop should also be at the start address until the next program is loaded
+        cycle = 0u;
+        pendingFault = NoFault;
+        writtenPages = 0u;
+        counters = PerformanceCounters();
     }
 
     // Load The Program From The File
@@ -128,12 +166,10 @@ public:
         // If the file is read successfully
         if (file.is_open())
         {
-            // First Clear The Variables From The Last Opened File
-            clearEmulator();
-            // Next Get size of file 
+            // Get size of file 
             std::streampos size = file.tellg();
             // If the file is larger than the available memory throw an exception
-            if (size > 0x1000){
+            if (size > static_cast<std::streamoff>(0x1000 - START_ADDRESS)){
                 throw std::length_error("File size exceeds available memory");
             }
 
@@ -145,18 +181,8 @@ public:
             file.read(buffer, size);
             file.close();
 
-            // Load the ROM contents into the emulators memory, starting at 0x200
-            for (long i = 0; i < size; ++i)
-            {
-                memory[START_ADDRESS + i] = buffer[i];
-                // Increment The Stop Value
-                pcStop += 1;
-            }
-
-            // If the stop value is odd (ends in a partial instruction) decrement it by 1
-            if (pcStop % 2 != 0){
-                --pcStop;
-            }
+            // Load the ROM contents into the emulators memory
+            loadProgram(reinterpret_cast<const unsigned char *>(buffer), static_cast<size_t>(size));
 
             // Free the buffer
             delete[] buffer;
@@ -169,18 +195,97 @@ public:
         }
     }
 
-    // Execute The Next Instruction From The Program
-    void nextInstruction()
+    // Load The Program From A Buffer Already In Memory
+    void loadProgram(const unsigned char *program, size_t size)
+    {
+        // If the program is larger than the available memory throw an exception
+        if (size > 0x1000 - START_ADDRESS){
+            throw std::length_error("File size exceeds available memory");
+        }
+
+        // First Clear The Variables From The Last Opened File
+        clearEmulator();
+
+        // Load the ROM contents into the emulators memory, starting at 0x200
+        for (size_t i = 0; i < size; ++i)
+        {
+            memory[START_ADDRESS + i] = program[i];
+            // Increment The Stop Value
+            pcStop += 1;
+        }
+
+        // If the stop value is odd (ends in a partial instruction) decrement it by 1
+        if (pcStop % 2 != 0){
+            --pcStop;
+        }
+    }
+
+    // Seed The Random Number Generator (Used By Tools That Need Repeatable Runs)
+    void seedRandom(unsigned int seed)
+    {
+        // xorshift32 can never leave the zero state, so zero is replaced with a fixed non zero seed
+        randomState = (seed != 0u) ? seed : 0x2545F491u;
+    }
+
+    // Set The Keypad From A 16 Bit Mask (Bit N Set Means Key N Is Pressed)
+    void setKeys(unsigned short keyMask)
+    {
+        keypad.store(keyMask);
+    }
+
+    /* Make This Emulator A Save State Of Another, Copying Everything That Decides Its Future (Memory, Registers, Timers, Display, Keys,
+    Random State And Counters) But Keeping Its Own Settings (soundEnabled, watchpoints, inputLatency). Assigning One Chip8 To Another
+    Copies Memory One Byte At A Time, This Copies Each Array In One Go*/
+    void copyState(const Chip8 &other);
+
+    // Hash The Registers, Index, Program Counter And Display (64 bit FNV-1a Over Their Bytes), Used To Cheaply Compare Two Emulators
+    unsigned long long hashState() const
+    {
+        unsigned long long hash = 0xCBF29CE484222325ull;
+        // Mix In The Low "bytes" Bytes Of A Value, One Byte At A Time
+        auto mix = [&hash](unsigned long long value, int bytes)
+        {
+            for (int i = 0; i < bytes; i++)
+            {
+                hash ^= (value >> (8 * i)) & 0xFFu;
+                hash *= 0x100000001B3ull;
+            }
+        };
+
+        for (int i = 0; i < 16; i++)
+        {
+            mix(registers[i], 1);
+        }
+        mix(index, 2);
+        mix(pc, 2);
+        // Every Row Of The Display Is Mixed In Whole, So No Two Pixels Share A Bit Of The Input
+        for (int y = 0; y < 32; y++)
+        {
+            mix(video[y], 8);
+        }
+        return hash;
+    }
+
+    /* Execute The Next Instruction From The Program, Returning Why It Could Not Be Executed Instead Of Throwing
+    A Faulting Instruction Leaves The Program Counter Past It And The Timers And Cycle Count Untouched*/
+    Fault step()
     {
         //If the program has not reached the end of its instructions
         if (pc < pcStop){
 
-            // First Read The Two-Byte Opcode From Memory
-            opcode = (memory[pc] << 8u) | memory[(pc + 1)];
+            // First Read The Two-Byte Opcode From Memory (An Instruction At 0xFFF Ends At 0x000)
+            opcode = (memory[pc] << 8u) | memory[(pc + 1) & 0x0FFFu];
             // Second increment the program counter by 2
             pc += 2;
             // Decode The Opcode Using The Function Table To Determine Which Operation Needs To Be Performed
             ((*this).*(MASTER_TABLE[(opcode & 0xF000u) >> 12u]))();
+            // The Invalid Operations Leave A Fault Behind Instead Of Throwing
+            if (pendingFault != NoFault)
+            {
+                Fault fault = pendingFault;
+                pendingFault = NoFault;
+                return fault;
+            }
 
             // If The Delay Timer Has Been Set, Decrement It
             if (delayTimer > 0)
@@ -191,84 +296,292 @@ public:
             // If The Sound Timer Has Been Set, Decrement It And Make Sound
             if (soundTimer > 0)
             {
-                // Make Sound
-                Beep(300, 10);
+                // Make Sound (Headless Tools Turn This Off So The Beep Does Not Stall Them)
+                if (soundEnabled)
+                {
+                    Beep(300, 10);
+                }
                 --soundTimer;
             }
 
+            // Count The Instruction
+            ++cycle;
+            return NoFault;
+        }
         //If the program has reached the end of its instructions (Chip-8 programs do not have a stop character, and therefore should always loop)
-        }else{
-            //Indicate that the problem is with the program itself
-            throw std::out_of_range("ERROR The CHIP-8 program terminated unexpectedly (Out of Instructions)");
+        //Indicate that the problem is with the program itself
+        return OutOfInstructions;
+    }
+
+    // Execute The Next Instruction From The Program, Throwing The Fault's Exception If It Cannot Be Executed
+    void nextInstruction()
+    {
+        Fault fault = step();
+        if (fault != NoFault)
+        {
+            ++counters.faults;
+            raiseFault(fault, opcode);
+        }
+    }
+
+    // Describe A Fault Returned By step() Just Now, Counting "executed" Instructions Run Before It
+    RunResult faulted(Fault fault, unsigned long long executed)
+    {
+        ++counters.faults;
+        RunResult result;
+        result.fault = fault;
+        result.pc = (fault == OutOfInstructions) ? pc : static_cast<unsigned short>(pc - 2);
+        result.opcode = (fault == OutOfInstructions) ? 0u : opcode;
+        result.executed = executed;
+        return result;
+    }
+
+    // True If The Program Is Jumping To Itself With Both Timers Stopped, After Which Nothing Can Ever Change
+    bool halted() const
+    {
+        return delayTimer == 0 && soundTimer == 0 && pc + 1 < pcStop && static_cast<unsigned int>((memory[pc] << 8u) | memory[pc + 1]) == (0x1000u | pc);
+    }
+
+    /* Skip Through An Idle Loop At The Program Counter Without Executing It One Instruction At A Time, Leaving The Emulator Exactly
+    As Executing The Skipped Instructions Would Have, Returns How Many Instructions Were Skipped (At Most "budget", 0 If Not Idle)*/
+    unsigned long long skipIdle(unsigned long long budget)
+    {
+        // The Sound Timer Beeps Once Per Instruction, So Only Silent Loops Are Skipped
+        if ((soundTimer > 0 && soundEnabled) || pc + 1 >= pcStop)
+        {
+            return 0;
+        }
+        unsigned short current = (memory[pc] << 8u) | memory[pc + 1];
+
+        /* A Jump To Itself (1nnn Where nnn Is Its Own Address) Only Ever Counts Down The Timers, And So Does A Key Wait (Fx0A)
+        Until A Key Is Pressed Or Released*/
+        if (current == (0x1000u | pc) || (waitingForKey && (current & 0xF0FFu) == 0xF00Au && keypad.load() == keyWaitMask))
+        {
+            if (current != (0x1000u | pc))
+            {
+                counters.keyWaitCycles += budget;
+            }
+            delayTimer = (delayTimer > budget) ? static_cast<unsigned char>(delayTimer - budget) : 0u;
+            soundTimer = (soundTimer > budget) ? static_cast<unsigned char>(soundTimer - budget) : 0u;
+            opcode = current;
+            cycle += budget;
+            return budget;
+        }
+
+        // Fx07, 3x00, 1nnn Back To The Fx07 Waits For The Delay Timer, Which Falls By 3 Each Time Around The Loop
+        if (pc + 5 < pcStop && (current & 0xF0FFu) == 0xF007u)
+        {
+            unsigned short vxIndex = (current & 0x0F00u) >> 8u;
+            unsigned short test = (memory[pc + 2] << 8u) | memory[pc + 3];
+            unsigned short jump = (memory[pc + 4] << 8u) | memory[pc + 5];
+            unsigned long long loops = (budget < delayTimer) ? budget / 3 : delayTimer / 3;
+            if (test == (0x3000u | (vxIndex << 8u)) && jump == (0x1000u | pc) && loops > 0)
+            {
+                // Every Loop Reads A Non Zero Timer, So The Last Loop Leaves VX Holding The Timer As It Was Before It
+                registers[vxIndex] = static_cast<unsigned char>(delayTimer - 3 * (loops - 1));
+                delayTimer -= static_cast<unsigned char>(3 * loops);
+                soundTimer = (soundTimer > 3 * loops) ? static_cast<unsigned char>(soundTimer - 3 * loops) : 0u;
+                opcode = jump;
+                cycle += 3 * loops;
+                return 3 * loops;
+            }
+        }
+        return 0;
+    }
+
+    // True If The Program Is Parked On A Key Wait (Fx0A) With Both Timers Stopped, So Nothing Changes Until A Key Does
+    bool waitingOnKeys() const
+    {
+        return waitingForKey && delayTimer == 0 && soundTimer == 0 && keypad.load() == keyWaitMask;
+    }
+
+    /* Execute "count" Instructions With run(), Skipping Straight Through Any Idle Loops On The Way, Stopping Early Only On A Fault
+    run() goes IDLE_CHECK_INTERVAL instructions at a time, so a program that settles into an idle loop is skipped through soon after*/
+    static constexpr unsigned long long IDLE_CHECK_INTERVAL = 64;
+    RunResult runInstructions(unsigned long long count)
+    {
+        unsigned long long executed = 0;
+        while (executed < count)
+        {
+            unsigned long long skipped = skipIdle(count - executed);
+            if (skipped == 0)
+            {
+                RunResult result = run((count - executed < IDLE_CHECK_INTERVAL) ? count - executed : IDLE_CHECK_INTERVAL);
+                executed += result.executed;
+                if (!result.ok())
+                {
+                    result.executed = executed;
+                    return result;
+                }
+                continue;
+            }
+            executed += skipped;
+        }
+        RunResult result;
+        result.executed = executed;
+        return result;
+    }
+
+    /* Execute Up To "cycleBudget" Instructions In One Call, Stopping Early Only On A Fault (The Same Instructions step() Would Run)
+    The program counter, index, stack pointer, timers and opcode stay in locals for the whole loop and are written back only when it
+    returns or before an instruction that needs them in the emulator (drawing, a key wait, memory that is being watched)*/
+    RunResult run(unsigned long long cycleBudget);
+    // How run() Dispatches Instructions In This Build ("switch", Or "threaded" When Built With CHIP8_THREADED_DISPATCH)
+    static const char *runDispatch();
+
+    // Note That "length" Bytes Were Stored From "address" (Wrapping At The End Of Memory) In writtenPages, Stores Never Span More Than Two Pages
+    void markWritten(unsigned int address, unsigned int length)
+    {
+        writtenPages |= static_cast<unsigned short>((1u << ((address & 0x0FFFu) / PAGE_SIZE)) | (1u << (((address + length - 1u) & 0x0FFFu) / PAGE_SIZE)));
+    }
+
+    // What The Program Has Done Since It Was Loaded Or resetPerformance() Was Called
+    PerformanceCounters::Totals performance() const { return counters.totals(cycle, delayTimer, soundTimer); }
+    void resetPerformance() { counters.reset(cycle, delayTimer, soundTimer); }
+
+    // Read One Pixel Of The Display (1 If It Is On)
+    unsigned int pixel(int x, int y) const
+    {
+        return static_cast<unsigned int>((video[y] >> (63 - x)) & 1u);
+    }
+
+    // Count The Set Bits Of A Sprite Row (Without Relying On A Population Count Instruction)
+    static unsigned int setBits(unsigned char value)
+    {
+        unsigned int bits = value - ((value >> 1u) & 0x55u);
+        bits = (bits & 0x33u) + ((bits >> 2u) & 0x33u);
+        return (bits + (bits >> 4u)) & 0x0Fu;
+    }
+
+    /* Draw A Sprite Of "height" Rows From "spriteAddress" At VX, VY As OP_Dxyn Does (Without Reporting The Reads To Watchpoints)
+    XORing Each Row Into The Display In One Go And Setting VF If Any Pixel Was Turned Off*/
+    void drawSprite(unsigned int vxIndex, unsigned int vyIndex, unsigned int height, unsigned short spriteAddress)
+    {
+        // Reset the collision flag (VF) to 0
+        registers[0xF] = 0;
+        ++counters.draws;
+
+        for (unsigned int row = 0; row < height; ++row)
+        {
+            unsigned char spriteData = memory[(spriteAddress + row) & 0x0FFFu];
+            counters.pixelsToggled += setBits(spriteData);
+            if (vxIndex != 0xFu && vyIndex != 0xFu)
+            {
+                // Line The Row Up With The Leftmost Pixel, Then Rotate It Into Place So Pixels Past The Right Edge Wrap Around
+                unsigned int x = registers[vxIndex] % 64u;
+                unsigned int y = (registers[vyIndex] + row) % 32u;
+                unsigned long long sprite = static_cast<unsigned long long>(spriteData) << 56u;
+                unsigned long long rowMask = (x == 0u) ? sprite : ((sprite >> x) | (sprite << (64u - x)));
+                if ((video[y] & rowMask) != 0u)
+                {
+                    registers[0xF] = 1;
+                }
+                video[y] ^= rowMask;
+            }
+            else
+            {
+                // Drawing At VF Moves The Sprite As Soon As A Collision Sets VF, So VX And VY Are Read Again For Every Pixel
+                for (unsigned int col = 0; col < 8; ++col)
+                {
+                    if ((spriteData & (0x80u >> col)) != 0u)
+                    {
+                        unsigned int x = (registers[vxIndex] + col) % 64u;
+                        unsigned int y = (registers[vyIndex] + row) % 32u;
+                        unsigned long long bit = 1ull << (63u - x);
+                        video[y] ^= bit;
+                        if ((video[y] & bit) == 0u)
+                        {
+                            registers[0xF] = 1;
+                        }
+                    }
+                }
+            }
         }
+        counters.collisions += registers[0xF];
     }
 
-    // Public Variables And Constructors
+    /* Public Variables And Constructors
+    The state every instruction touches comes first and fills one 64 byte cache line (the class is aligned to it), then memory and the
+    display, then the state only a few instructions or the tools use. The font and the function tables are shared by every emulator*/
 public:
     // This Is The Storage Of The Chip-8 Program, It Contains Sixteen 8 bit registers to Store Program Results
     unsigned char registers[16]{};
-    /*
-    This Is The Memory Of The Chip-8 Program, It Contains 4096 Bytes Of Memory To Be Used As Follows:
-    0x000 - 0x1FF : Originally Used To Store The Chip-8 Interpreter, The Emulator Should Not Use These Values
-    0x050 - 0x0A0 : Stores The 16 Built In Characters Of Chip-8 (0,1,2,3,4,5,6,7,8,9,A,B,C,D,E,F)
-    0x200 - 0xFFF : Program Instructions Are Stored In This Section
-    */
-    unsigned char memory[0x1000]{};
+    // This Is The Program Stack, It contains One 16 bit register to store the program order of execution
+    unsigned short stack[16]{};
     // This Is The Index Register of The Chip-8 Program, It contains One 16 bit register To store memory addresses that other operations will make use of
     unsigned short index = 0u;
     // This Is The Program Counter of The Chip-8 Program, It contains One 16 bit register To store the memory address of the next instruction to execute
     unsigned short pc = 0u;
-    // This Is The Program Stack, It contains One 16 bit register to store the program order of execution
-    unsigned short stack[16]{};
+    // This Is The Operation Code, It stores what instruction is being performed by the emulator.
+    unsigned short opcode = 0u;
+    // This Is The Stop Value, When The Program Counter Reaches This Value The Program Ceases
+    unsigned short pcStop = 0x200;
     // This is The Stack Pointer, It contains One 8 bit register to store the memory address to the top of the Stack (The most recently added instruction)
     unsigned char sp = 0u;
     // This is The Built In Delay Timer, It contains One 8 bit register to store a value used for timing in the program
     unsigned char delayTimer = 0u;
     // This is The Built In Sound Timer, It contains One 8 bit register and will play a sound every time it is decremented until reaching 0
     unsigned char soundTimer = 0u;
-    /*This is The Key Register, It contains One 8 Bit register to store which input keys are currently being pressed / not being pressed,
-    Every key exists in a state of pressed (1) or unpressed (0)*/
-    unsigned char keypad[16]{};
+
+    /*
+    This Is The Memory Of The Chip-8 Program, It Contains 4096 Bytes Of Memory To Be Used As Follows:
+    0x000 - 0x1FF : Originally Used To Store The Chip-8 Interpreter, The Emulator Should Not Use These Values
+    0x050 - 0x0A0 : Stores The 16 Built In Characters Of Chip-8 (0,1,2,3,4,5,6,7,8,9,A,B,C,D,E,F)
+    0x200 - 0xFFF : Program Instructions Are Stored In This Section
+    */
+    alignas(64) unsigned char memory[0x1000]{};
     /*This is The Display Memory, It stores which pixels in a 64 x 32 pixel grid have been drawn, each pixel is either on (1) or off (0) pixels
-    drawn off screen wrap around to the other side of the screen*/
-    unsigned int video[32][64]{};
-    // This Is The Operation Code, It stores what instruction is being performed by the emulator.
-    unsigned short opcode;
+    drawn off screen wrap around to the other side of the screen. Each row is one 64 bit word with the leftmost pixel in the highest bit*/
+    unsigned long long video[32]{};
 
-    // This Is The Stop Value, When The Program Counter Reaches This Value The Program Ceases
-    unsigned short pcStop = 0x200;
+    /*This is The Key Register, It stores which input keys are currently being pressed / not being pressed,
+    Every key exists in a state of pressed (1) or unpressed (0), one bit per key so the GUI thread can update it at any time*/
+    KeyMask keypad;
+    // These Track A Wait For A Key (OP_Fx0A), Which Keys Have Been Held Down Since The Wait Began And If A Wait Is In Progress
+    unsigned short keyWaitMask = 0u;
+    bool waitingForKey = false;
+
+    // This Determines If The Sound Timer Should Make A Sound
+    bool soundEnabled = true;
+
+    // This Is The State Of The Random Number Generator, It Is Part Of The Emulator So Runs Can Be Repeated
+    unsigned int randomState = 1u;
+
+    // This Is How Many Instructions Have Been Executed Since The Program Was Loaded
+    unsigned long long cycle = 0u;
+
+    // Chip8 Memory Is Tracked In 16 Pages Of 256 Bytes When Noting Which Parts Of It The Program Has Written
+    static constexpr unsigned int PAGE_SIZE = 0x100;
+    static constexpr unsigned int PAGE_COUNT = 0x1000 / PAGE_SIZE;
+    /*These Are The Pages Of Memory The Program Has Stored To (Fx33, Fx55) Since It Was Loaded, One Bit Per 256 Byte Page,
+    So Copies Of The Emulator Can Be Saved And Restored A Page At A Time (See Chip8Pool.h). Anything Else That Writes Memory Should Call markWritten()*/
+    unsigned short writtenPages = 0u;
+
+    // These Count What The Program Has Done, Read Them With performance() (See PerformanceCounters.h)
+    PerformanceCounters counters;
+
+    // These Are The Memory Watchpoints Checked By The Memory Instructions, Or Null When Nothing Is Watched (Copies Share Them)
+    Watchpoints *watchpoints = nullptr;
+
+    // This Measures How Long Key Events Take To Be Read By The Keypad Instructions, Or Null When Not Measuring (Copies Share It)
+    InputLatency *inputLatency = nullptr;
 
     // Constructor
     Chip8();
 
     // Private Function Tables and Emulator Functions
 private:
-    // function pointer table (This Table Redirects To Other Tables And Holds Instructions In Which The Entire OpCode Is Unique)
-    Chip8Table MASTER_TABLE[16] = {
-        &Chip8::Table0,
-        &Chip8::OP_1nnn,
-        &Chip8::OP_2nnn,
-        &Chip8::OP_3xnn,
-        &Chip8::OP_4xnn,
-        &Chip8::OP_5xy0,
-        &Chip8::OP_6xnn,
-        &Chip8::OP_7xnn,
-        &Chip8::Table8,
-        &Chip8::OP_9xy0,
-        &Chip8::OP_Annn,
-        &Chip8::OP_Bnnn,
-        &Chip8::OP_Cxnn,
-        &Chip8::OP_Dxyn,
-        &Chip8::TableE,
-        &Chip8::TableF};
-    // function pointer sub tables Intializes Their Values To Automatically Point To The Command Not Found Function (OP_NULL)
-    Chip8Table subTable0[3] = {}; // subtable0 no longer needs any values set to OP_NULL (impossible to call OP_NULL when starting opcode digit is 0)
-
-    Chip8Table subTable8[15] = {setNull(subTable8, 15)};
-
-    Chip8Table subTableE[15] = {setNull(subTableE, 15)};
-
-    Chip8Table subTableF[102] = {setNull(subTableF, 102)};
+    // The Fault Left By The Instruction Being Executed, Picked Up (And Cleared) By step()
+    Fault pendingFault = NoFault;
+
+    /*function pointer table (This Table Redirects To Other Tables And Holds Instructions In Which The Entire OpCode Is Unique)
+    The tables never change, so they are built once in Chip8.cpp and shared by every emulator instead of being copied into each one*/
+    static const Chip8Table MASTER_TABLE[16];
+    // function pointer sub tables, Every Value Without An Instruction Points To The Command Not Found Function (OP_NULL)
+    static const Chip8Table subTable0[3];
+    static const Chip8Table subTable8[16];
+    static const Chip8Table subTableE[16];
+    static const std::array<Chip8Table, 102> subTableF;
 
     // Instruction List Function Implementation
 
@@ -294,10 +607,10 @@ private:
     }
 
     // Table 0 Functions
-    // This operation is invalid, and when run throws an exception explaining why
+    // This operation is invalid, and when run stops execution with a fault explaining why
     void OP_0nnn()
     {
-        throw UnsupportedLanguageException("ERROR, The Operation: " + toHexString(opcode) + " Indicates That This Program Is Dependent Upon An Nonexistent Machine Language Subroutine");
+        pendingFault = UnsupportedLanguage;
     }
     // Clear screen/display
     void OP_00E0()
@@ -312,9 +625,9 @@ private:
             sp--;
             pc = stack[sp]; // decrement stack pointer and set program counter to stack[sp] to undue what was done in function OP_2nnn
         }
-        else if(sp == 0)
+        else
         {
-            throw std::runtime_error("Stack underflow: Stack pointer is 0");
+            pendingFault = StackUnderflow;
         }
     }
 
@@ -436,14 +749,14 @@ private:
         unsigned short vxIndex = (opcode & 0x0F00u) >> 8u;
         unsigned short vyIndex = (opcode & 0x00F0u) >> 4u;
 
-        registers[0xFu] = registers[vyIndex] >> 3u;    // get the most significant bit of VY and set VF to it
+        registers[0xFu] = registers[vyIndex] >> 7u;    // get the most significant bit of VY and set VF to it
         registers[vxIndex] = registers[vyIndex] << 1u; // set VX to VY shifted left one bit
     }
 
     // Stores A Pointer To The Two Instructions Beginning With: E
     void TableE()
     {
-        ((*this).*(subTable8[opcode & 0x000Fu]))();
+        ((*this).*(subTableE[opcode & 0x000Fu]))();
     }
 
     // Table E Functions
@@ -452,9 +765,12 @@ private:
     {
         unsigned short vxIndex = (opcode & 0x0F00u) >> 8u;
         unsigned char vxValue = registers[vxIndex];
-        qDebug() << "OP_Ex9E()";
+        if (inputLatency != nullptr)
+        {
+            inputLatency->observed();
+        }
 
-        if (keypad[vxValue] == 0)
+        if (vxValue > 0xF || !keypad.pressed(vxValue))
         {
             pc += 2; // increase program counter by 2 to skip the current instruction
         }
@@ -464,9 +780,12 @@ private:
     {
         unsigned short vxIndex = (opcode & 0x0F00u) >> 8u;
         unsigned char vxValue = registers[vxIndex];
-        qDebug() << "OP_Ex9E()";
+        if (inputLatency != nullptr)
+        {
+            inputLatency->observed();
+        }
 
-        if (keypad[vxValue] != 0)
+        if (vxValue <= 0xF && keypad.pressed(vxValue))
         {
             pc += 2;
         }
@@ -475,7 +794,15 @@ private:
     // Stores A Pointer To The Nine Instructions Beginning With: F
     void TableF()
     {
-        ((*this).*(subTableF[opcode & 0x00FFu]))();
+        // The Table Only Reaches 0x65 (The Last F Instruction), Anything Past It Is Unrecognized
+        if ((opcode & 0x00FFu) < 102u)
+        {
+            ((*this).*(subTableF[opcode & 0x00FFu]))();
+        }
+        else
+        {
+            OP_NULL();
+        }
     }
 
     // Table F Functions
@@ -486,27 +813,45 @@ private:
 
         registers[vxIndex] = delayTimer;
     }
-    // Wait for a keypress and store the result in register VX
+    /*Wait for a key to be pressed and released, then store the released key in register VX
+     * While waiting the instruction repeats (the timers keep counting down) and run loops can sleep until a key changes (see waitingOnKeys)*/
     void OP_Fx0A()
     {
         unsigned short vxIndex = (opcode & 0x0F00u) >> 8u;
-        bool keyPressed = false; // Bool to determine if a key has been pressed
-
+        if (inputLatency != nullptr)
+        {
+            inputLatency->observed();
+        }
+        unsigned short held = keypad.load();
+        unsigned short released = keyWaitMask & ~held; // keys that were down earlier in the wait and are now up
 
-        if (keypad[vxIndex]){
-            registers[vxIndex] = static_cast<unsigned char>(vxIndex);
-            qDebug() << "register[" <<vxIndex <<"] = " << vxIndex;
-            keyPressed = true;
-        }else{
+        if (released != 0u)
+        {
+            // Take The Lowest Key That Was Let Go
+            unsigned char key = 0u;
+            while (((released >> key) & 1u) == 0u)
+            {
+                ++key;
+            }
+            registers[vxIndex] = key;
+            keyWaitMask = 0u;
+            waitingForKey = false;
+        }
+        else
+        {
+            // Remember Every Key Held So Far And Repeat This Instruction
+            keyWaitMask |= held;
+            waitingForKey = true;
+            ++counters.keyWaitCycles;
             pc -= 2;
         }
-
     }
     // Set the delay timer to the value of register VX
     void OP_Fx15()
     {
         unsigned short vxIndex = (opcode & 0x0F00u) >> 8u;
 
+        counters.setDelay(delayTimer, registers[vxIndex]);
         delayTimer = registers[vxIndex];
     }
     // Set the sound timer to the value of register VX
@@ -514,6 +859,7 @@ private:
     {
         unsigned short vxIndex = (opcode & 0x0F00u) >> 8u;
 
+        counters.setSound(soundTimer, registers[vxIndex]);
         soundTimer = registers[vxIndex];
     }
     // Add the value stored in register VX to register I
@@ -540,9 +886,18 @@ private:
         unsigned char tens = (registers[vxIndex] % 100) / 10; // Get the tens digit
         unsigned char units = registers[vxIndex] % 10;        // Get the unit digit
 
-        memory[index] = hundreds; // Places the digits in memory addresses
-        memory[index + 1] = tens;
-        memory[index + 2] = units;
+        markWritten(index, 3);
+        memory[index & 0x0FFFu] = hundreds; // Places the digits in memory addresses (wrapping at the end of memory)
+        memory[(index + 1) & 0x0FFFu] = tens;
+        memory[(index + 2) & 0x0FFFu] = units;
+
+        if (watchpoints != nullptr)
+        {
+            for (unsigned int i = 0; i < 3; i++)
+            {
+                watchpoints->write((index + i) & 0x0FFFu, memory[(index + i) & 0x0FFFu], pc - 2, cycle);
+            }
+        }
     }
     /*Store the values of registers V0 to VX inclusive in memory starting at address I
      * I is set to I + X + 1 after operation²*/
@@ -550,9 +905,14 @@ private:
     {
         unsigned short vxIndex = (opcode & 0x0F00u) >> 8u;
 
+        markWritten(index, vxIndex + 1u);
         for (unsigned int i = 0x0u; i <= vxIndex; i++)
         { // loop through and assign memory[index] to a register until VX is reached, then loops 1 more time and exits loop
-            memory[index] = registers[i];
+            memory[index & 0x0FFFu] = registers[i];
+            if (watchpoints != nullptr)
+            {
+                watchpoints->write(index & 0x0FFFu, registers[i], pc - 2, cycle);
+            }
             index++; // increment index after each assignment
         }
     }
@@ -564,7 +924,11 @@ private:
 
         for (unsigned int i = 0x0u; i <= vxIndex; i++)
         { // loop through and assign registers to memory[index] until VX is reached, then loops 1 more time and exits loop
-            registers[i] = memory[index];
+            registers[i] = memory[index & 0x0FFFu];
+            if (watchpoints != nullptr)
+            {
+                watchpoints->read(index & 0x0FFFu, registers[i], pc - 2, cycle);
+            }
             index++;
         }
     }
@@ -581,6 +945,11 @@ private:
     void OP_2nnn()
     {
         unsigned short address = opcode & 0x0FFFu; // get hexadecimal memory address nnn from the opcode and assign it to a variable
+        if (sp >= 16u)
+        {
+            pendingFault = StackOverflow;
+            return;
+        }
         stack[sp] = pc;                            // program counter is stored in the stack array so the subroutine can be returned from
         ++sp;
         pc = address; // set program counter to the obtained address
@@ -610,8 +979,8 @@ private:
     // Skip the following instruction if the value of register VX is equal to the value of register VY
     void OP_5xy0()
     {
-        unsigned short vxIndex = (opcode & 0x0FFFu) >> 8u;
-        unsigned short vyIndex = (opcode & 0x0FFFu) >> 4u;
+        unsigned short vxIndex = (opcode & 0x0F00u) >> 8u;
+        unsigned short vyIndex = (opcode & 0x00F0u) >> 4u;
 
         if (registers[vxIndex] == registers[vyIndex])
         {
@@ -635,8 +1004,8 @@ private:
     // Skip the following instruction if the value of register VX is not equal to the value of register VY
     void OP_9xy0()
     {
-        unsigned short vxIndex = (opcode & 0x0FFFu) >> 8u;
-        unsigned short vyIndex = (opcode & 0x0FFFu) >> 4u;
+        unsigned short vxIndex = (opcode & 0x0F00u) >> 8u;
+        unsigned short vyIndex = (opcode & 0x00F0u) >> 4u;
 
         if (registers[vxIndex] != registers[vyIndex])
         {
@@ -675,38 +1044,23 @@ private:
         // Get the starting memory address for the sprite data
         unsigned short spriteAddress = index;
 
-        // Reset the collision flag (VF) to 0
-        registers[0xF] = 0;
-
-        // Loop through each row of the sprite
-        for (unsigned int row = 0; row < height; ++row) {
-            // Get the sprite data from memory
-            unsigned char spriteData = memory[spriteAddress + row];
-
-            // Loop through each pixel in the row
-            for (unsigned int col = 0; col < 8; ++col) {
-                // Extract the pixel value from the spriteData
-                unsigned char pixelValue = (spriteData & (0x80u >> col)) >> (7 - col);
-
-                // Calculate the position of the pixel on the screen
-                int x = (registers[vxIndex] + col) % 64;
-                int y = (registers[vyIndex] + row) % 32;
-
-                // XOR the pixel value with the current screen value
-                video[y][x] ^= pixelValue;
-
-                // Set VF to 1 if any set pixels are changed to unset
-                if (pixelValue == 1 && video[y][x] == 0) {
-                    registers[0xF] = 1;
-                }
+        // Report Each Row Of The Sprite Data Read From Memory
+        if (watchpoints != nullptr)
+        {
+            for (unsigned int row = 0; row < height; ++row)
+            {
+                watchpoints->read((spriteAddress + row) & 0x0FFFu, memory[(spriteAddress + row) & 0x0FFFu], pc - 2, cycle);
             }
         }
+
+        // Draw the sprite one row at a time, setting VF to 1 if any set pixels are changed to unset
+        drawSprite(vxIndex, vyIndex, height, spriteAddress);
     }
 
     // Operation Not Found Function
     void OP_NULL()
     {
-        throw NullOperationException("ERROR, The Operation: " + toHexString(opcode) + " Is Unrecognized");
+        pendingFault = NullOperation;
     }
 };
 #endif
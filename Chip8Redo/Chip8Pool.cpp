@@ -0,0 +1,272 @@
+#include <cstring>  //For Copying Pages
+#include <iterator> //For Walking The Maps While Erasing
+#include "Chip8Pool.h"
+
+//Constructor
+Chip8Pool::Chip8Pool(size_t maxInstances, bool soundEnabled)
+    : maxInstances(maxInstances)
+{
+    worker.soundEnabled = soundEnabled;
+    emptyImage = imageOf(worker);
+    workerImage = emptyImage;
+}
+
+// Make An Instance With No Program Loaded
+size_t Chip8Pool::create(unsigned int seed)
+{
+    size_t number;
+    if (!freeInstances.empty())
+    {
+        number = freeInstances.back();
+        freeInstances.pop_back();
+    }
+    else if (instances.size() < maxInstances)
+    {
+        number = instances.size();
+        instances.emplace_back();
+    }
+    else
+    {
+        return NO_INSTANCE;
+    }
+
+    Instance &instance = instances[number];
+    instance.used = true;
+    instance.image = emptyImage;
+    instance.state = State();
+    restart(instance);
+    // xorshift32 can never leave the zero state, so zero is replaced with a fixed non zero seed (as in Chip8::seedRandom())
+    instance.state.randomState = (seed != 0u) ? seed : 0x2545F491u;
+    ++used;
+    return number;
+}
+
+// Free An Instance's Number And Pages
+void Chip8Pool::destroy(size_t number)
+{
+    if (!exists(number))
+    {
+        return;
+    }
+    // The Worker Keeps The Destroyed Instance's Pages, Which writtenPages Still Describes, So The Next Switch Puts Them Back
+    if (workerInstance == number)
+    {
+        workerInstance = NO_INSTANCE;
+    }
+    Instance &instance = instances[number];
+    instance.used = false;
+    instance.image.reset();
+    for (std::unique_ptr<Page> &page : instance.pages)
+    {
+        page.reset();
+    }
+    instance.privatePages = 0u;
+    freeInstances.push_back(number);
+    --used;
+}
+
+// Load A Program Into An Instance
+void Chip8Pool::loadProgram(size_t number, const unsigned char *program, size_t size)
+{
+    std::vector<unsigned char> rom(program, program + size);
+    std::shared_ptr<const Image> image = images[rom].lock();
+    if (!image)
+    {
+        // The Program Is Loaded Into A Plain Chip8 Once, So The Image Is Exactly What loadProgram() Makes
+        std::unique_ptr<Chip8> loaded(new Chip8());
+        loaded->loadProgram(program, size);
+        image = imageOf(*loaded);
+        images[rom] = image;
+    }
+    instances[number].image = image;
+    reset(number);
+}
+
+// Put An Instance Back To The State Its Program Was Loaded In
+void Chip8Pool::reset(size_t number)
+{
+    // Whatever The Worker Holds For This Instance Is Thrown Away
+    if (workerInstance == number)
+    {
+        workerInstance = NO_INSTANCE;
+    }
+    restart(instances[number]);
+}
+
+// Switch The Worker To An Instance
+Chip8 &Chip8Pool::emulator(size_t number)
+{
+    if (workerInstance == number)
+    {
+        return worker;
+    }
+    storeWorker();
+
+    Instance &instance = instances[number];
+    // The Same Program Only Differs In The Pages Either Instance Wrote, Another Program Differs Everywhere
+    unsigned short stale = (instance.image == workerImage) ? static_cast<unsigned short>(worker.writtenPages | instance.privatePages) : 0xFFFFu;
+    for (unsigned int page = 0; page < Chip8::PAGE_COUNT; page++)
+    {
+        if ((stale >> page) & 1u)
+        {
+            const Page &source = instance.pages[page] ? *instance.pages[page] : *instance.image->pages[page];
+            std::memcpy(worker.memory + page * Chip8::PAGE_SIZE, source.data(), Chip8::PAGE_SIZE);
+        }
+    }
+    loadState(instance.state, worker);
+    worker.writtenPages = instance.privatePages;
+    workerImage = instance.image;
+    workerInstance = number;
+    return worker;
+}
+
+size_t Chip8Pool::sharedPageCount() const
+{
+    size_t count = 0;
+    for (const auto &entry : pages)
+    {
+        if (!entry.second.expired())
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+size_t Chip8Pool::privatePageCount() const
+{
+    size_t count = 0;
+    for (const Instance &instance : instances)
+    {
+        for (unsigned int page = 0; page < Chip8::PAGE_COUNT; page++)
+        {
+            count += (instance.privatePages >> page) & 1u;
+        }
+    }
+    return count;
+}
+
+size_t Chip8Pool::residentBytes() const
+{
+    return sizeof(*this) + instances.capacity() * sizeof(Instance) + (sharedPageCount() + privatePageCount()) * sizeof(Page);
+}
+
+// Build (Or Find) The Image Of A Loaded Emulator's Memory, Sharing Every Page Already Held
+std::shared_ptr<const Chip8Pool::Image> Chip8Pool::imageOf(const Chip8 &loaded)
+{
+    std::shared_ptr<Image> image = std::make_shared<Image>();
+    for (unsigned int page = 0; page < Chip8::PAGE_COUNT; page++)
+    {
+        image->pages[page] = sharedPage(loaded.memory + page * Chip8::PAGE_SIZE);
+    }
+    image->pcStop = loaded.pcStop;
+
+    // Forget Programs And Pages Nothing Uses Any More
+    for (auto entry = images.begin(); entry != images.end();)
+    {
+        entry = entry->second.expired() ? images.erase(entry) : std::next(entry);
+    }
+    for (auto entry = pages.begin(); entry != pages.end();)
+    {
+        entry = entry->second.expired() ? pages.erase(entry) : std::next(entry);
+    }
+    return image;
+}
+
+// The Shared Copy Of A Page's Contents
+std::shared_ptr<const Chip8Pool::Page> Chip8Pool::sharedPage(const unsigned char *bytes)
+{
+    Page contents;
+    std::memcpy(contents.data(), bytes, Chip8::PAGE_SIZE);
+    std::weak_ptr<const Page> &entry = pages[contents];
+    std::shared_ptr<const Page> page = entry.lock();
+    if (!page)
+    {
+        page = std::make_shared<const Page>(contents);
+        entry = page;
+    }
+    return page;
+}
+
+// Drop An Instance's Private Pages And Give It Its Program's Starting State
+void Chip8Pool::restart(Instance &instance)
+{
+    for (unsigned int page = 0; page < Chip8::PAGE_COUNT; page++)
+    {
+        if ((instance.privatePages >> page) & 1u)
+        {
+            instance.pages[page].reset();
+        }
+    }
+    instance.privatePages = 0u;
+
+    // Chip8::clearEmulator() Leaves The Random Number State Alone
+    unsigned int randomState = instance.state.randomState;
+    instance.state = State();
+    instance.state.pcStop = instance.image->pcStop;
+    instance.state.randomState = randomState;
+}
+
+// Copy The Worker Back Into Its Instance, Only The Pages It Has Written
+void Chip8Pool::storeWorker()
+{
+    if (workerInstance == NO_INSTANCE)
+    {
+        return;
+    }
+    Instance &instance = instances[workerInstance];
+    saveState(worker, instance.state);
+    for (unsigned int page = 0; page < Chip8::PAGE_COUNT; page++)
+    {
+        if ((worker.writtenPages >> page) & 1u)
+        {
+            if (!instance.pages[page])
+            {
+                instance.pages[page].reset(new Page);
+            }
+            std::memcpy(instance.pages[page]->data(), worker.memory + page * Chip8::PAGE_SIZE, Chip8::PAGE_SIZE);
+        }
+    }
+    instance.privatePages = worker.writtenPages;
+    workerInstance = NO_INSTANCE;
+}
+
+void Chip8Pool::saveState(const Chip8 &emulator, State &state)
+{
+    std::memcpy(state.registers, emulator.registers, sizeof(state.registers));
+    std::memcpy(state.stack, emulator.stack, sizeof(state.stack));
+    state.index = emulator.index;
+    state.pc = emulator.pc;
+    state.opcode = emulator.opcode;
+    state.pcStop = emulator.pcStop;
+    state.sp = emulator.sp;
+    state.delayTimer = emulator.delayTimer;
+    state.soundTimer = emulator.soundTimer;
+    state.waitingForKey = emulator.waitingForKey;
+    state.keys = emulator.keypad.load();
+    state.keyWaitMask = emulator.keyWaitMask;
+    state.randomState = emulator.randomState;
+    state.cycle = emulator.cycle;
+    std::memcpy(state.video, emulator.video, sizeof(state.video));
+    state.counters = emulator.counters;
+}
+
+void Chip8Pool::loadState(const State &state, Chip8 &emulator)
+{
+    std::memcpy(emulator.registers, state.registers, sizeof(state.registers));
+    std::memcpy(emulator.stack, state.stack, sizeof(state.stack));
+    emulator.index = state.index;
+    emulator.pc = state.pc;
+    emulator.opcode = state.opcode;
+    emulator.pcStop = state.pcStop;
+    emulator.sp = state.sp;
+    emulator.delayTimer = state.delayTimer;
+    emulator.soundTimer = state.soundTimer;
+    emulator.waitingForKey = state.waitingForKey;
+    emulator.setKeys(state.keys);
+    emulator.keyWaitMask = state.keyWaitMask;
+    emulator.randomState = state.randomState;
+    emulator.cycle = state.cycle;
+    std::memcpy(emulator.video, state.video, sizeof(state.video));
+    emulator.counters = state.counters;
+}
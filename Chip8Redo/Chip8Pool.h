@@ -0,0 +1,112 @@
+#ifndef CHIP8POOL_H
+#define CHIP8POOL_H
+//ensure header is only declared once
+#include <array>  //For The Page Tables
+#include <map>    //For Sharing Identical Pages And Programs
+#include <memory> //For The Shared Pages
+#include <vector> //For The Instances
+#include "Chip8.h"
+
+/*
+A Pool Of Many Emulators That Only Keeps The Memory Each One Has Changed
+A Chip8 carries all 4 KB of its memory, so ten thousand of them cost 45 MB even though nearly all of that memory is the same
+font and the same ROM. The pool instead keeps each instance's registers, stack, timers and display, plus a page table of 16
+pages of 256 bytes. Every page starts out pointing at a read only page of the program's image, and images share their pages
+with each other, so the font, the zero pages and any ROM loaded by more than one instance are held once. An instance only gets
+a private copy of a page once it stores to it (Fx33 or Fx55, found through Chip8::writtenPages).
+Instances are run on the pool's one emulator: emulator() switches it to an instance, copying back the pages the previous one
+wrote and copying in the pages the new one differs by, so switching, creating and resetting cost the pages written rather than
+the whole memory. Switching between instances of different programs copies all 16 pages. The emulator returned is only valid
+until the next call to the pool, and settings such as soundEnabled, watchpoints and inputLatency belong to it, not to the instances.
+*/
+class Chip8Pool
+{
+public:
+    static constexpr size_t NO_INSTANCE = static_cast<size_t>(-1);
+
+    // Constructor, Holding At Most "maxInstances" Instances At Once
+    explicit Chip8Pool(size_t maxInstances, bool soundEnabled = true);
+
+    // Make An Instance With No Program Loaded (As A New Chip8 Is), Returns Its Number Or NO_INSTANCE If The Pool Is Full
+    size_t create(unsigned int seed);
+    // Free An Instance's Number And Pages For Reuse
+    void destroy(size_t instance);
+    bool exists(size_t instance) const { return instance < instances.size() && instances[instance].used; }
+
+    // Load A Program Into An Instance (As Chip8::loadProgram() Does, Throwing If It Is Too Large), Sharing Its Pages With Every Instance Running It
+    void loadProgram(size_t instance, const unsigned char *program, size_t size);
+    // Put An Instance Back To The State Its Program Was Loaded In, Keeping Its Random Number State
+    void reset(size_t instance);
+
+    // The Emulator Running An Instance, Valid Until The Next Call To The Pool
+    Chip8 &emulator(size_t instance);
+
+    // What The Pool Is Holding
+    size_t instanceCount() const { return used; }
+    size_t sharedPageCount() const;  // distinct pages held by the loaded programs
+    size_t privatePageCount() const; // pages copied by instances that stored to them
+    size_t residentBytes() const;    // roughly everything above, instances included
+
+private:
+    typedef std::array<unsigned char, Chip8::PAGE_SIZE> Page;
+
+    // The Memory And Starting State Of A Loaded Program, Shared By Every Instance Running It
+    struct Image
+    {
+        std::array<std::shared_ptr<const Page>, Chip8::PAGE_COUNT> pages;
+        unsigned short pcStop = 0x200;
+    };
+
+    // Everything In A Chip8 Apart From Its Memory And Its Settings
+    struct State
+    {
+        unsigned char registers[16]{};
+        unsigned short stack[16]{};
+        unsigned short index = 0u;
+        unsigned short pc = 0x200;
+        unsigned short opcode = 0u;
+        unsigned short pcStop = 0x200;
+        unsigned char sp = 0u;
+        unsigned char delayTimer = 0u;
+        unsigned char soundTimer = 0u;
+        bool waitingForKey = false;
+        unsigned short keys = 0u;
+        unsigned short keyWaitMask = 0u;
+        unsigned int randomState = 1u;
+        unsigned long long cycle = 0u;
+        unsigned long long video[32]{};
+        PerformanceCounters counters;
+    };
+
+    struct Instance
+    {
+        bool used = false;
+        State state;
+        std::shared_ptr<const Image> image;
+        unsigned short privatePages = 0u; // one bit per page held in "pages"
+        std::array<std::unique_ptr<Page>, Chip8::PAGE_COUNT> pages;
+    };
+
+    std::shared_ptr<const Image> imageOf(const Chip8 &loaded);
+    std::shared_ptr<const Page> sharedPage(const unsigned char *bytes);
+    void restart(Instance &instance);
+    void storeWorker();
+    static void saveState(const Chip8 &emulator, State &state);
+    static void loadState(const State &state, Chip8 &emulator);
+
+    std::vector<Instance> instances;
+    std::vector<size_t> freeInstances;
+    size_t maxInstances;
+    size_t used = 0;
+
+    std::shared_ptr<const Image> emptyImage;                        // the font and nothing else, for instances with no program
+    std::map<std::vector<unsigned char>, std::weak_ptr<const Image>> images; // by ROM
+    std::map<Page, std::weak_ptr<const Page>> pages;                // by contents
+
+    // The Emulator Instances Run On, Its Memory Is Always workerImage Apart From The Pages Set In worker.writtenPages
+    Chip8 worker;
+    std::shared_ptr<const Image> workerImage;
+    size_t workerInstance = NO_INSTANCE;
+};
+
+#endif // CHIP8POOL_H
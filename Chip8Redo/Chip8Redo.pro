@@ -1,27 +1,80 @@
-QT       += core gui
+QT       += core gui network
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++17
 
+# Build Chip8::run() with a computed goto after every operation instead of one switch (GCC/Clang/MinGW only):
+# qmake CONFIG+=threaded_dispatch, then compare the two builds with Chip8Redo --bench rom
+threaded_dispatch: DEFINES += CHIP8_THREADED_DISPATCH
+
 # You can make your code fail to compile if it uses deprecated APIs.
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
     ApplicationLoop.cpp \
+    BatchChip8.cpp \
     Chip8.cpp \
+    Chip8Pool.cpp \
+    ControlFlowGraph.cpp \
+    Debugger.cpp \
+    DiffTester.cpp \
+    FrameCapture.cpp \
+    Headless.cpp \
+    InputLatency.cpp \
+    Phosphor.cpp \
+    PredecodedChip8.cpp \
+    Recompiler.cpp \
+    RegressionTests.cpp \
+    RunAhead.cpp \
+    StateSearch.cpp \
+    TraceDatabase.cpp \
+    Upscaler.cpp \
+    Watchpoints.cpp \
     bindkeys.cpp \
+    debuggerpanel.cpp \
+    emulationserver.cpp \
+    emulationthread.cpp \
+    gridview.cpp \
+    instrumentationpanel.cpp \
     keybinds.cpp \
     main.cpp \
-    mainwindow.cpp
+    mainwindow.cpp \
+    performanceoverlay.cpp
 
 HEADERS += \
     ApplicationLoop.h \
+    BatchChip8.h \
     Chip8.h \
+    Chip8Pool.h \
+    ControlFlowGraph.h \
+    Debugger.h \
+    DiffTester.h \
+    FrameCapture.h \
+    Headless.h \
+    InputLatency.h \
+    PerformanceCounters.h \
+    Phosphor.h \
+    PredecodedChip8.h \
+    RecompiledRuntime.h \
+    Recompiler.h \
+    RegressionTests.h \
+    RunAhead.h \
+    StateSearch.h \
+    TraceDatabase.h \
+    TripleBuffer.h \
+    Upscaler.h \
+    Watchpoints.h \
     bindkeys.h \
+    debuggerpanel.h \
+    emulationserver.h \
+    emulationthread.h \
+    gridview.h \
+    instrumentationpanel.h \
     keybinds.h \
-    mainwindow.h
+    mainwindow.h \
+    performanceoverlay.h
 
 FORMS += \
     bindkeys.ui \
@@ -0,0 +1,407 @@
+#include <cstdio>  //For Formatting Addresses
+#include <sstream> //For Building The Output
+#include "ControlFlowGraph.h"
+
+//Constructor
+ControlFlowGraph::ControlFlowGraph(const Chip8 &emulator)
+    : end(emulator.pcStop), kinds(0x1000, Unknown), instructionStarts(0x1000, 0)
+{
+    for (int i = 0; i < 0x1000; i++)
+    {
+        memory[i] = emulator.memory[i];
+    }
+
+    discover();
+    formBlocks();
+    findData();
+}
+
+// Classify An Opcode The Same Way The Emulator's Function Tables Decode It
+ControlFlowGraph::Flow ControlFlowGraph::flowOf(unsigned short opcode)
+{
+    unsigned int n = opcode & 0x000Fu;
+    unsigned int nn = opcode & 0x00FFu;
+    switch (opcode >> 12u)
+    {
+    case 0x0:
+        if (opcode == 0x00E0u)
+        {
+            return Continue;
+        }
+        return (opcode == 0x00EEu) ? Return : Invalid;
+    case 0x1:
+        return Jump;
+    case 0x2:
+        return Call;
+    case 0x3:
+    case 0x4:
+        return Skip;
+    case 0x5:
+    case 0x9:
+        return (n == 0x0u) ? Skip : Invalid;
+    case 0x8:
+        return (n <= 0x7u || n == 0xEu) ? Continue : Invalid;
+    case 0xB:
+        return Indirect;
+    case 0xE:
+        return (nn == 0x9Eu || nn == 0xA1u) ? Skip : Invalid;
+    case 0xF:
+        switch (nn)
+        {
+        case 0x07:
+        case 0x0A:
+        case 0x15:
+        case 0x18:
+        case 0x1E:
+        case 0x29:
+        case 0x33:
+        case 0x55:
+        case 0x65:
+            return Continue;
+        }
+        return Invalid;
+    }
+    // 6xnn, 7xnn, Annn, Cxnn and Dxyn
+    return Continue;
+}
+
+// Follow Every Path From The Entry Point, Marking Each Reachable Instruction And The Addresses That Start Blocks
+void ControlFlowGraph::discover()
+{
+    std::vector<unsigned short> pending;
+    pending.push_back(ENTRY_ADDRESS);
+    leaders.insert(ENTRY_ADDRESS);
+    subroutineEntries.insert(ENTRY_ADDRESS);
+
+    while (!pending.empty())
+    {
+        unsigned short address = pending.back();
+        pending.pop_back();
+
+        // Keep Walking Straight Ahead Until The Path Ends Or Joins Code Already Seen
+        while (inProgram(address) && !instructionStarts[address])
+        {
+            instructionStarts[address] = 1;
+            kinds[address] |= Code;
+            kinds[address + 1] |= Code;
+
+            unsigned short opcode = opcodeAt(address);
+            unsigned short target = opcode & 0x0FFFu;
+            unsigned short next = address + 2;
+            Flow flow = flowOf(opcode);
+
+            switch (flow)
+            {
+            case Call:
+                subroutineEntries.insert(target);
+                leaders.insert(target);
+                pending.push_back(target);
+                break;
+            case Jump:
+                leaders.insert(target);
+                pending.push_back(target);
+                break;
+            case Skip:
+                leaders.insert(next);
+                leaders.insert(next + 2);
+                pending.push_back(next);
+                pending.push_back(next + 2);
+                break;
+            case Indirect:
+                indirectJumpAddresses.push_back(address);
+                break;
+            default:
+                break;
+            }
+
+            if (endsBlock(flow))
+            {
+                // The Instruction After A Block Ending Instruction Starts A Block If Anything Reaches It
+                leaders.insert(next);
+                break;
+            }
+            address = next;
+        }
+    }
+}
+
+// Split The Reachable Instructions Into Blocks At Every Leader
+void ControlFlowGraph::formBlocks()
+{
+    for (unsigned short leader : leaders)
+    {
+        if (!inProgram(leader) || !instructionStarts[leader])
+        {
+            continue;
+        }
+
+        Block block;
+        block.start = leader;
+        unsigned short address = leader;
+        while (true)
+        {
+            unsigned short opcode = opcodeAt(address);
+            unsigned short next = address + 2;
+            Flow flow = flowOf(opcode);
+
+            if (flow == Call)
+            {
+                block.calls.push_back(opcode & 0x0FFFu);
+            }
+
+            if (endsBlock(flow))
+            {
+                block.end = next;
+                switch (flow)
+                {
+                case Jump:
+                    block.successors.push_back(opcode & 0x0FFFu);
+                    break;
+                case Skip:
+                    block.successors.push_back(next);
+                    block.successors.push_back(next + 2);
+                    break;
+                case Return:
+                    block.returns = true;
+                    break;
+                case Indirect:
+                    block.indirect = true;
+                    break;
+                default:
+                    block.invalid = true;
+                    break;
+                }
+                break;
+            }
+
+            // A Block Also Ends Where The Next One Starts (Or Where The Program Does)
+            if (!inProgram(next) || !instructionStarts[next] || leaders.count(next) != 0)
+            {
+                block.end = next;
+                if (inProgram(next) && instructionStarts[next])
+                {
+                    block.successors.push_back(next);
+                }
+                break;
+            }
+            address = next;
+        }
+
+        // Only Keep Edges To Blocks That Exist (A Skip Past The End Of The Program Leads Nowhere)
+        std::vector<unsigned short> reachable;
+        for (unsigned short successor : block.successors)
+        {
+            if (inProgram(successor) && instructionStarts[successor])
+            {
+                reachable.push_back(successor);
+            }
+        }
+        block.successors = reachable;
+        blockMap[leader] = block;
+    }
+}
+
+// Within Each Block Track The Index Register From Annn, And Mark The Bytes The Memory Instructions Use With It
+void ControlFlowGraph::findData()
+{
+    for (const auto &entry : blockMap)
+    {
+        const Block &block = entry.second;
+        bool indexKnown = false;
+        unsigned int index = 0;
+
+        for (unsigned short address = block.start; address < block.end; address += 2)
+        {
+            unsigned short opcode = opcodeAt(address);
+            unsigned int x = (opcode & 0x0F00u) >> 8u;
+            unsigned int n = opcode & 0x000Fu;
+
+            if ((opcode & 0xF000u) == 0xA000u)
+            {
+                index = opcode & 0x0FFFu;
+                indexKnown = true;
+            }
+            else if ((opcode & 0xF000u) == 0xD000u && indexKnown)
+            {
+                for (unsigned int row = 0; row < n; row++)
+                {
+                    kinds[(index + row) & 0x0FFFu] |= Sprite;
+                }
+            }
+            else if ((opcode & 0xF0FFu) == 0xF033u && indexKnown)
+            {
+                for (unsigned int i = 0; i < 3; i++)
+                {
+                    kinds[(index + i) & 0x0FFFu] |= Data;
+                }
+            }
+            else if (((opcode & 0xF0FFu) == 0xF055u || (opcode & 0xF0FFu) == 0xF065u) && indexKnown)
+            {
+                // Fx55 And Fx65 Leave The Index Just Past The Bytes They Used
+                for (unsigned int i = 0; i <= x; i++)
+                {
+                    kinds[(index + i) & 0x0FFFu] |= Data;
+                }
+                index += x + 1;
+            }
+            else if ((opcode & 0xF0FFu) == 0xF01Eu || (opcode & 0xF0FFu) == 0xF029u)
+            {
+                // Fx1E And Fx29 Depend On A Register, So The Index Is No Longer Known
+                indexKnown = false;
+            }
+        }
+    }
+}
+
+// Find The Block That Contains An Address
+const ControlFlowGraph::Block *ControlFlowGraph::blockAt(unsigned short address) const
+{
+    auto after = blockMap.upper_bound(address);
+    if (after == blockMap.begin())
+    {
+        return nullptr;
+    }
+    --after;
+    return (address < after->second.end) ? &after->second : nullptr;
+}
+
+// Each Subroutine And Every Subroutine Called From The Blocks It Can Reach Without Calling
+std::map<unsigned short, std::set<unsigned short>> ControlFlowGraph::callGraph() const
+{
+    std::map<unsigned short, std::set<unsigned short>> graph;
+    for (unsigned short entry : subroutineEntries)
+    {
+        std::set<unsigned short> &callees = graph[entry];
+        std::set<unsigned short> visited;
+        std::vector<unsigned short> pending(1, entry);
+        while (!pending.empty())
+        {
+            unsigned short start = pending.back();
+            pending.pop_back();
+            auto block = blockMap.find(start);
+            if (block == blockMap.end() || !visited.insert(start).second)
+            {
+                continue;
+            }
+            callees.insert(block->second.calls.begin(), block->second.calls.end());
+            pending.insert(pending.end(), block->second.successors.begin(), block->second.successors.end());
+        }
+    }
+    return graph;
+}
+
+// The Name Used For A Block In The Output
+std::string ControlFlowGraph::label(unsigned short address) const
+{
+    char text[16];
+    std::snprintf(text, sizeof(text), "%s_%03X", subroutineEntries.count(address) != 0 ? "sub" : "loc", address);
+    return text;
+}
+
+// A Listing Of The Whole Program, Labelling Blocks And Showing Bytes That Are Not Code As DB
+std::string ControlFlowGraph::text() const
+{
+    std::ostringstream out;
+    char line[96];
+
+    std::snprintf(line, sizeof(line), "; 0x%03X - 0x%03X: %zu blocks, %zu subroutines, %zu indirect jumps\n",
+                  ENTRY_ADDRESS, end, blockMap.size(), subroutineEntries.size(), indirectJumpAddresses.size());
+    out << line;
+
+    unsigned short address = ENTRY_ADDRESS;
+    while (address < end)
+    {
+        if (instructionStarts[address] && address + 1 < end)
+        {
+            auto block = blockMap.find(address);
+            if (block != blockMap.end())
+            {
+                out << "\n" << label(address) << ":\n";
+            }
+
+            unsigned short opcode = opcodeAt(address);
+            std::string comment;
+            Flow flow = flowOf(opcode);
+            if (flow == Indirect)
+            {
+                comment = "  ; indirect jump";
+            }
+            else if (flow == Invalid)
+            {
+                comment = "  ; cannot be executed";
+            }
+            else if (flow == Jump && (opcode & 0x0FFFu) == address)
+            {
+                comment = "  ; jumps to itself";
+            }
+            std::snprintf(line, sizeof(line), "    0x%03X  %04X  ", address, opcode);
+            out << line << disassemble(opcode) << comment << "\n";
+            address += 2;
+        }
+        else
+        {
+            // A Byte Nothing Executes, Sprites Are Drawn As Eight Characters So They Can Be Recognised
+            unsigned char value = memory[address];
+            std::string comment = (kinds[address] & Sprite) ? "sprite " : (kinds[address] & Data) ? "data" : "unreached";
+            if (kinds[address] & Sprite)
+            {
+                for (int bit = 7; bit >= 0; bit--)
+                {
+                    comment += ((value >> bit) & 1u) ? '#' : '.';
+                }
+            }
+            std::snprintf(line, sizeof(line), "    0x%03X  %02X    DB 0x%02X  ; ", address, value, value);
+            out << line << comment << "\n";
+            address += 1;
+        }
+    }
+    return out.str();
+}
+
+// The Blocks As Graphviz Nodes, Solid Edges For Control Flow And Dashed Edges For Calls
+std::string ControlFlowGraph::graphviz() const
+{
+    std::ostringstream out;
+    char line[64];
+
+    out << "digraph rom {\n";
+    out << "    node [shape=box fontname=\"Courier\"];\n";
+    for (const auto &entry : blockMap)
+    {
+        const Block &block = entry.second;
+        out << "    b" << std::hex << block.start << std::dec << " [label=\"" << label(block.start) << ":\\l";
+        for (unsigned short address = block.start; address < block.end; address += 2)
+        {
+            std::snprintf(line, sizeof(line), "0x%03X  ", address);
+            out << line << disassemble(opcodeAt(address)) << "\\l";
+        }
+        out << "\"";
+        if (block.indirect)
+        {
+            out << " color=red xlabel=\"indirect\"";
+        }
+        else if (block.invalid)
+        {
+            out << " color=orange";
+        }
+        else if (block.returns)
+        {
+            out << " peripheries=2";
+        }
+        out << "];\n";
+
+        for (unsigned short successor : block.successors)
+        {
+            out << "    b" << std::hex << block.start << " -> b" << successor << std::dec << ";\n";
+        }
+        for (unsigned short callee : block.calls)
+        {
+            if (blockMap.count(callee) != 0)
+            {
+                out << "    b" << std::hex << block.start << " -> b" << callee << std::dec << " [style=dashed label=\"call\"];\n";
+            }
+        }
+    }
+    out << "}\n";
+    return out.str();
+}
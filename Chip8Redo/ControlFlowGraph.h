@@ -0,0 +1,93 @@
+#ifndef CONTROLFLOWGRAPH_H
+#define CONTROLFLOWGRAPH_H
+//ensure header is only declared once
+#include <map>    //For The Blocks And Call Graph
+#include <set>    //For The Subroutine Entries
+#include <string> //For The Text And Graphviz Output
+#include <vector> //For The Block Edges
+#include "Chip8.h"
+
+/*
+Static Analysis Of A Loaded ROM
+Starting at 0x200 the analysis follows every path the program can take (jumps, calls, returns and both sides of every skip)
+without running it, splits the reachable instructions into basic blocks and records which subroutines call which.
+Bytes that are never reached as instructions but are drawn as sprites (Annn followed by Dxyn in the same block) or used
+by Fx33 / Fx55 / Fx65 are marked as data. Bnnn jumps depend on V0 at run time, so their targets cannot be known and the
+blocks ending in them are flagged instead.
+*/
+class ControlFlowGraph
+{
+public:
+    // What A Byte Of Memory Was Found To Be (A Byte Can Be More Than One)
+    enum ByteKind : unsigned char
+    {
+        Unknown = 0,
+        Code = 1,   // part of a reachable instruction
+        Sprite = 2, // drawn by Dxyn
+        Data = 4    // read or written by Fx33, Fx55 or Fx65
+    };
+
+    // A Run Of Instructions That Always Execute Together, Entered Only At "start"
+    struct Block
+    {
+        unsigned short start = 0;
+        unsigned short end = 0;                  // one past the last instruction
+        std::vector<unsigned short> successors;  // the blocks control can continue to (not counting calls)
+        std::vector<unsigned short> calls;       // the subroutines called from this block, in order
+        bool returns = false;                    // ends in 00EE
+        bool indirect = false;                   // ends in Bnnn, whose target depends on V0
+        bool invalid = false;                    // ends in an instruction the emulator cannot execute
+    };
+
+    // Constructor (Analyses The Program Loaded In The Emulator, Between 0x200 And Its pcStop)
+    explicit ControlFlowGraph(const Chip8 &emulator);
+
+    // Results
+    const std::map<unsigned short, Block> &blocks() const { return blockMap; }
+    const Block *blockAt(unsigned short address) const; // the block containing an address, or null
+    const std::set<unsigned short> &subroutines() const { return subroutineEntries; }
+    const std::vector<unsigned short> &indirectJumps() const { return indirectJumpAddresses; }
+    std::map<unsigned short, std::set<unsigned short>> callGraph() const; // each subroutine and the subroutines it calls
+    unsigned char kind(unsigned short address) const { return kinds[address & 0x0FFFu]; }
+    bool isInstruction(unsigned short address) const { return instructionStarts[address & 0x0FFFu] != 0; }
+    unsigned short programEnd() const { return end; }
+
+    // Output
+    std::string text() const;     // a labelled disassembly listing, with data bytes shown as DB
+    std::string graphviz() const; // the blocks and edges as a Graphviz digraph
+
+private:
+    // How An Instruction Affects The Flow Of Control
+    enum Flow
+    {
+        Continue, // falls through to the next instruction
+        Call,     // 2nnn, continues at the next instruction once the subroutine returns
+        Jump,     // 1nnn
+        Skip,     // 3xnn, 4xnn, 5xy0, 9xy0, Ex9E, ExA1
+        Return,   // 00EE
+        Indirect, // Bnnn
+        Invalid   // 0nnn and unrecognised opcodes
+    };
+    static Flow flowOf(unsigned short opcode);
+    static bool endsBlock(Flow flow) { return flow != Continue && flow != Call; }
+
+    unsigned short opcodeAt(unsigned short address) const { return (memory[address & 0x0FFFu] << 8u) | memory[(address + 1) & 0x0FFFu]; }
+    bool inProgram(unsigned short address) const { return address >= ENTRY_ADDRESS && address + 1 < end; }
+    void discover();
+    void formBlocks();
+    void findData();
+    std::string label(unsigned short address) const;
+
+    static constexpr unsigned short ENTRY_ADDRESS = 0x200; // where every Chip8 program starts
+
+    unsigned char memory[0x1000];
+    unsigned short end;
+    std::vector<unsigned char> kinds;             // a ByteKind mask for every address
+    std::vector<unsigned char> instructionStarts; // 1 where a reachable instruction starts
+    std::set<unsigned short> leaders;             // the addresses that start a block
+    std::map<unsigned short, Block> blockMap;
+    std::set<unsigned short> subroutineEntries;
+    std::vector<unsigned short> indirectJumpAddresses;
+};
+
+#endif // CONTROLFLOWGRAPH_H
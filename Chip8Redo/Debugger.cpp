@@ -0,0 +1,265 @@
+#include "Debugger.h"
+
+//Constructor
+Debugger::Debugger()
+{
+    clearBreakpoints();
+}
+
+// Check A Condition Against The Emulator
+bool Debugger::Condition::holds(const Chip8 &emulator) const
+{
+    return holds((target == INDEX_TARGET) ? emulator.index : emulator.registers[target & 0xF]);
+}
+
+// Check A Condition Against The Value Its Register Holds (Or Held, When Looking Back Through A Recording)
+bool Debugger::Condition::holds(unsigned short current) const
+{
+    switch (comparison)
+    {
+    case Equal:
+        return current == value;
+    case NotEqual:
+        return current != value;
+    case Less:
+        return current < value;
+    case Greater:
+        return current > value;
+    }
+    return false;
+}
+
+// Stop Whenever The Program Counter Reaches An Address
+void Debugger::addBreakpoint(unsigned short address)
+{
+    address &= 0x0FFFu;
+    if (!hasBreakpoint(address))
+    {
+        breakpoints[address >> 6u] |= 1ull << (address & 63u);
+        ++breakpointCount;
+    }
+    conditions.erase(address);
+}
+
+// Stop When The Program Counter Reaches An Address And The Condition Holds
+void Debugger::addBreakpoint(unsigned short address, const Condition &condition)
+{
+    addBreakpoint(address);
+    conditions[address & 0x0FFFu] = condition;
+}
+
+void Debugger::removeBreakpoint(unsigned short address)
+{
+    address &= 0x0FFFu;
+    if (hasBreakpoint(address))
+    {
+        breakpoints[address >> 6u] &= ~(1ull << (address & 63u));
+        --breakpointCount;
+    }
+    conditions.erase(address);
+}
+
+void Debugger::clearBreakpoints()
+{
+    for (unsigned long long &word : breakpoints)
+    {
+        word = 0u;
+    }
+    conditions.clear();
+    breakpointCount = 0;
+}
+
+// Returns True (And Remembers It) If The Next Instruction Is On A Breakpoint That Should Stop
+bool Debugger::stopsBefore(const Chip8 &emulator)
+{
+    if (stoppedHere || !hasBreakpoint(emulator.pc))
+    {
+        return false;
+    }
+    auto condition = conditions.find(emulator.pc & 0x0FFFu);
+    if (condition != conditions.end() && !condition->second.holds(emulator))
+    {
+        return false;
+    }
+    stoppedHere = true;
+    return true;
+}
+
+// Execute One Instruction, After Which A Breakpoint At The New Address Can Stop Again
+Debugger::StopReason Debugger::execute(Chip8 &emulator)
+{
+    stoppedHere = false;
+    unsigned long long hitsBefore = watchpoints.hitCount();
+    Chip8::Fault fault = recording ? trace.step(emulator) : emulator.step();
+    if (fault != Chip8::NoFault)
+    {
+        lastFault = emulator.faulted(fault, 0);
+        return Faulted;
+    }
+    return (watchpoints.hitCount() != hitsBefore) ? WatchpointHit : BudgetUsed;
+}
+
+// A Finished Step Counts As Stopping Here, So Continuing Does Not Stop Again On A Breakpoint At The New Address
+Debugger::StopReason Debugger::finishStep(const Chip8 &emulator)
+{
+    stoppedHere = hasBreakpoint(emulator.pc);
+    return StepFinished;
+}
+
+// Run Until A Breakpoint Is Reached Or The Budget Is Used Up
+Debugger::StopReason Debugger::run(Chip8 &emulator, unsigned long long budget)
+{
+    for (unsigned long long i = 0; i < budget; i++)
+    {
+        if (stopsBefore(emulator))
+        {
+            return BreakpointHit;
+        }
+        StopReason stop = execute(emulator);
+        if (stop != BudgetUsed)
+        {
+            return stop;
+        }
+    }
+    return BudgetUsed;
+}
+
+// Execute Exactly One Instruction
+Debugger::StopReason Debugger::stepInto(Chip8 &emulator)
+{
+    StopReason stop = execute(emulator);
+    finishStep(emulator);
+    return (stop != BudgetUsed) ? stop : StepFinished;
+}
+
+// Execute One Instruction, Running A Whole Subroutine If The Instruction Is A Call (OP_2nnn)
+Debugger::StopReason Debugger::stepOver(Chip8 &emulator, unsigned long long budget)
+{
+    unsigned short opcode = (emulator.memory[emulator.pc & 0x0FFFu] << 8u) | emulator.memory[(emulator.pc + 1) & 0x0FFFu];
+    if ((opcode & 0xF000u) != 0x2000u)
+    {
+        return stepInto(emulator);
+    }
+
+    // The Call Has Returned Once The Stack Is Back To Its Current Depth At The Following Instruction
+    unsigned char depth = emulator.sp;
+    unsigned short returnAddress = emulator.pc + 2;
+    StopReason stop = execute(emulator);
+    if (stop != BudgetUsed)
+    {
+        return stop;
+    }
+    for (unsigned long long i = 0; i < budget; i++)
+    {
+        if (emulator.sp == depth && emulator.pc == returnAddress)
+        {
+            return finishStep(emulator);
+        }
+        if (stopsBefore(emulator))
+        {
+            return BreakpointHit;
+        }
+        stop = execute(emulator);
+        if (stop != BudgetUsed)
+        {
+            return stop;
+        }
+    }
+    return BudgetUsed;
+}
+
+// Run Until The Current Subroutine Returns (OP_00EE Takes The Stack Below Its Current Depth)
+Debugger::StopReason Debugger::stepOut(Chip8 &emulator, unsigned long long budget)
+{
+    unsigned char depth = emulator.sp;
+    if (depth == 0)
+    {
+        return stepInto(emulator);
+    }
+
+    StopReason stop = execute(emulator);
+    if (stop != BudgetUsed)
+    {
+        return stop;
+    }
+    for (unsigned long long i = 0; i < budget; i++)
+    {
+        if (emulator.sp < depth)
+        {
+            return finishStep(emulator);
+        }
+        if (stopsBefore(emulator))
+        {
+            return BreakpointHit;
+        }
+        stop = execute(emulator);
+        if (stop != BudgetUsed)
+        {
+            return stop;
+        }
+    }
+    return BudgetUsed;
+}
+
+// Travel Back To The Start Of The Instruction Before The Current One
+Debugger::StopReason Debugger::stepBack(Chip8 &emulator)
+{
+    if (emulator.cycle <= trace.firstCycle())
+    {
+        return NotRecorded;
+    }
+    return travelTo(emulator, emulator.cycle - 1);
+}
+
+// Every Breakpoint's Latest Recorded Hit Before Now Whose Condition Held Then, The Latest Of Those Is Where To Stop
+Debugger::StopReason Debugger::reverseContinue(Chip8 &emulator)
+{
+    unsigned long long now = emulator.cycle;
+    if (trace.empty() || now <= trace.firstCycle() || now > trace.endCycle())
+    {
+        return NotRecorded;
+    }
+
+    bool found = false;
+    unsigned long long target = trace.firstCycle();
+    for (unsigned short address = 0; address < 0x1000u; address++)
+    {
+        if (!hasBreakpoint(address))
+        {
+            continue;
+        }
+        auto condition = conditions.find(address);
+        unsigned long long cycle = 0;
+        unsigned long long before = now;
+        while (trace.lastExecution(address, before, cycle) && (!found || cycle > target))
+        {
+            // A Condition Is Checked Against What Its Register Held Then, Found From The Recording Without Replaying Anything
+            if (condition == conditions.end() || condition->second.holds(trace.registerAt(condition->second.target, cycle)))
+            {
+                target = cycle;
+                found = true;
+                break;
+            }
+            // Every Execution Since The Register Last Changed Saw The Same Value, So Jump Straight To The Ones Before That Change
+            TraceDatabase::Write change;
+            if (!trace.lastRegisterChange(condition->second.target, cycle, change))
+            {
+                break;
+            }
+            before = change.cycle + 1u;
+        }
+    }
+
+    StopReason stop = travelTo(emulator, target);
+    return (stop == StepFinished && found) ? BreakpointHit : stop;
+}
+
+// Replay From The Recording, Leaving A Breakpoint At The Destination To Be Continued Past Rather Than Stopped At Again
+Debugger::StopReason Debugger::travelTo(Chip8 &emulator, unsigned long long cycle)
+{
+    if (emulator.cycle < trace.firstCycle() || emulator.cycle > trace.endCycle() || !trace.seek(emulator, cycle))
+    {
+        return NotRecorded;
+    }
+    return finishStep(emulator);
+}
@@ -0,0 +1,104 @@
+#ifndef DEBUGGER_H
+#define DEBUGGER_H
+//ensure header is only declared once
+#include <unordered_map> //For Breakpoint Conditions
+#include "Chip8.h"
+#include "TraceDatabase.h"
+#include "Watchpoints.h"
+
+/*
+Breakpoints And Stepping For A Chip8
+Breakpoints are kept as one bit per memory address, so checking the program counter is a single bit test.
+Memory watchpoints stop a run after the instruction that touched a watched address, once they are attached to the emulator.
+The debugger only runs instructions when it is active (a breakpoint or watchpoint is set, or it is recording), otherwise the caller
+keeps using Chip8::runInstructions() directly and pays nothing for the debugger existing. Faults are returned as Faulted, never thrown.
+While recording, every instruction the debugger runs goes into its TraceDatabase, and the program can be stepped backwards or
+continued backwards to the previous breakpoint hit anywhere within what was recorded.
+*/
+class Debugger
+{
+public:
+    // A Test On A Register Or The Index, A Conditional Breakpoint Only Stops When Its Condition Holds
+    struct Condition
+    {
+        enum Comparison
+        {
+            Equal,
+            NotEqual,
+            Less,
+            Greater
+        };
+
+        int target;            // 0x0 - 0xF for V0 - VF, INDEX_TARGET for the index register
+        Comparison comparison;
+        unsigned short value;
+
+        bool holds(const Chip8 &emulator) const;
+        bool holds(unsigned short current) const;
+    };
+    static constexpr int INDEX_TARGET = 16;
+
+    // Why Running Stopped
+    enum StopReason
+    {
+        BudgetUsed,    // every instruction asked for was executed
+        BreakpointHit, // the program counter reached a breakpoint whose condition holds
+        WatchpointHit, // the last instruction read or wrote a watched memory address
+        StepFinished,  // a step into, over or out of (or back) completed
+        Faulted,       // the emulator could not execute an instruction, see fault()
+        NotRecorded    // there is no recorded history to go back to
+    };
+
+    // Constructor
+    Debugger();
+
+    // Breakpoints
+    void addBreakpoint(unsigned short address);
+    void addBreakpoint(unsigned short address, const Condition &condition);
+    void removeBreakpoint(unsigned short address);
+    void clearBreakpoints();
+    bool hasBreakpoint(unsigned short address) const { return (breakpoints[(address & 0x0FFFu) >> 6u] >> (address & 63u)) & 1u; }
+    bool hasCondition(unsigned short address) const { return conditions.count(address & 0x0FFFu) != 0; }
+    bool active() const { return breakpointCount > 0 || watchpoints.any() || recording; }
+
+    // Memory Watchpoints, Checked By Any Emulator Whose "watchpoints" Points Here
+    Watchpoints watchpoints;
+    void attach(Chip8 &emulator) { emulator.watchpoints = &watchpoints; }
+
+    // Running And Stepping
+    StopReason run(Chip8 &emulator, unsigned long long budget);
+    StopReason stepInto(Chip8 &emulator);
+    StopReason stepOver(Chip8 &emulator, unsigned long long budget);
+    StopReason stepOut(Chip8 &emulator, unsigned long long budget);
+    // Where And Why The Emulator Faulted, After A Call Returned Faulted
+    const Chip8::RunResult &fault() const { return lastFault; }
+
+    // Recording Every Instruction The Debugger Runs, So The Program's History Can Be Searched And Revisited
+    TraceDatabase trace;
+    void setRecording(bool record) { recording = record; }
+    bool isRecording() const { return recording; }
+
+    // Going Backwards Through The Recording (NotRecorded If The Emulator Is Not Within It)
+    // Undo The Last Instruction
+    StopReason stepBack(Chip8 &emulator);
+    // Go Back To The Latest Recorded Breakpoint Hit Before Now, Or To The Start Of The Recording If There Was None
+    StopReason reverseContinue(Chip8 &emulator);
+    // Go To Any Recorded Cycle, For Example One Found By TraceDatabase::query()
+    StopReason travelTo(Chip8 &emulator, unsigned long long cycle);
+
+private:
+    // True If The Program Counter Is On A Breakpoint That Was Not Just Reported
+    bool stopsBefore(const Chip8 &emulator);
+    // Execute One Instruction, Returning WatchpointHit Or Faulted If It Has To Stop There (BudgetUsed Otherwise)
+    StopReason execute(Chip8 &emulator);
+    StopReason finishStep(const Chip8 &emulator);
+
+    unsigned long long breakpoints[64]; // 4096 bits, one per memory address
+    std::unordered_map<unsigned short, Condition> conditions;
+    int breakpointCount = 0;
+    bool stoppedHere = false; // true after reporting a breakpoint, so resuming does not stop on it again
+    bool recording = false;
+    Chip8::RunResult lastFault;
+};
+
+#endif // DEBUGGER_H
@@ -0,0 +1,231 @@
+#include <algorithm> //For Searching The Input Stream
+#include <memory>    //For Holding The Checkpoint Emulators
+#include "BatchChip8.h"
+#include "PredecodedChip8.h"
+#include "DiffTester.h"
+
+//Constructor
+DiffTester::DiffTester(Engine referenceEngine, Engine candidateEngine)
+    : reference(referenceEngine), candidate(candidateEngine)
+{
+}
+
+// Look Up An Engine By Name
+DiffTester::Engine DiffTester::engine(const std::string &name)
+{
+    // The Original Interpreter, One Instruction At A Time Through The MASTER_TABLE
+    if (name == "table")
+    {
+        return [](Chip8 &emulator, unsigned long long count)
+        {
+            Chip8::RunResult result;
+            for (; result.executed < count; ++result.executed)
+            {
+                Chip8::Fault fault = emulator.step();
+                if (fault != Chip8::NoFault)
+                {
+                    return emulator.faulted(fault, result.executed);
+                }
+            }
+            return result;
+        };
+    }
+    // The Original Interpreter, Skipping Through Idle Loops Instead Of Executing Them
+    if (name == "idle")
+    {
+        return [](Chip8 &emulator, unsigned long long count)
+        {
+            return emulator.runInstructions(count);
+        };
+    }
+    // The Batched Interpreter, Running Every Instruction In One Call With The Machine State In Locals
+    if (name == "run")
+    {
+        return [](Chip8 &emulator, unsigned long long count)
+        {
+            return emulator.run(count);
+        };
+    }
+    // The Predecoded Interpreter With Fused Sequences, Keeping Its Cache From One Call To The Next So The Invalidation Is Exercised
+    if (name == "predecoded")
+    {
+        std::shared_ptr<PredecodedChip8> predecoded = std::make_shared<PredecodedChip8>();
+        return [predecoded](Chip8 &emulator, unsigned long long count)
+        {
+            return predecoded->run(emulator, count);
+        };
+    }
+    // The Structure Of Arrays Core, With The State Copied Into Four Identical Lanes So The Grouped Execution Is Exercised
+    if (name == "batch")
+    {
+        return [](Chip8 &emulator, unsigned long long count)
+        {
+            BatchChip8 batch(4);
+            for (size_t lane = 0; lane < batch.laneCount(); lane++)
+            {
+                batch.loadLane(lane, emulator);
+            }
+            Chip8::RunResult result;
+            for (; result.executed < count && batch.fault(0) == BatchChip8::NoFault; ++result.executed)
+            {
+                batch.step();
+            }
+            batch.storeLane(0, emulator);
+            if (batch.fault(0) != BatchChip8::NoFault)
+            {
+                // The Faulting Step Did Not Complete
+                result.fault = static_cast<Chip8::Fault>(batch.fault(0));
+                result.opcode = batch.faultingOpcode(0);
+                result.pc = (result.fault == Chip8::OutOfInstructions) ? emulator.pc : static_cast<unsigned short>(emulator.pc - 2);
+                --result.executed;
+            }
+            return result;
+        };
+    }
+    return Engine();
+}
+
+// The Names Accepted By engine()
+std::vector<std::string> DiffTester::engineNames()
+{
+    return {"table", "idle", "run", "predecoded", "batch"};
+}
+
+// Set How Many Instructions Run Between Each Hash Comparison
+void DiffTester::setCompareInterval(unsigned long long instructions)
+{
+    compareInterval = (instructions > 0) ? instructions : 1;
+}
+
+// Set The Keypad Changes Both Engines Will Receive
+void DiffTester::setInputs(const std::vector<InputEvent> &events)
+{
+    inputs = events;
+    std::stable_sort(inputs.begin(), inputs.end(), [](const InputEvent &a, const InputEvent &b)
+                     { return a.cycle < b.cycle; });
+}
+
+// Run One Engine From Cycle "from" To Cycle "to", Applying The Input Stream Along The Way
+DiffTester::Outcome DiffTester::advance(Chip8 &emulator, const Engine &engine, unsigned long long from, unsigned long long to) const
+{
+    Outcome outcome;
+    auto byCycle = [](const InputEvent &event, unsigned long long cycle)
+    { return event.cycle < cycle; };
+
+    // First Apply The Key State That Was Active When The Run Reached "from"
+    auto next = std::lower_bound(inputs.begin(), inputs.end(), from + 1, byCycle);
+    if (next != inputs.begin())
+    {
+        emulator.setKeys((next - 1)->keys);
+    }
+
+    // Run Up To Each Input Event, Apply It, Then Keep Going
+    while (from < to)
+    {
+        unsigned long long stop = (next != inputs.end() && next->cycle < to) ? next->cycle : to;
+        Chip8::RunResult result = engine(emulator, stop - from);
+        if (!result.ok())
+        {
+            outcome.faulted = true;
+            outcome.message = Chip8::faultMessage(result.fault, result.opcode);
+            break;
+        }
+        from = stop;
+        // Apply Every Event Scheduled For This Cycle (The Last One Wins)
+        while (next != inputs.end() && next->cycle == from && from < to)
+        {
+            emulator.setKeys(next->keys);
+            ++next;
+        }
+    }
+
+    outcome.hash = emulator.hashState();
+    return outcome;
+}
+
+// Find The First Cycle In (from, to] At Which The Two Engines Disagree, Starting From Two Matching Checkpoints
+unsigned long long DiffTester::bisect(const Chip8 &referenceCheckpoint, const Chip8 &candidateCheckpoint, unsigned long long from, unsigned long long to) const
+{
+    unsigned long long good = from; // the engines are known to agree here
+    unsigned long long bad = to;    // and are known to disagree here
+
+    while (bad - good > 1)
+    {
+        unsigned long long middle = good + (bad - good) / 2;
+        Chip8 referenceProbe(referenceCheckpoint);
+        Chip8 candidateProbe(candidateCheckpoint);
+
+        if (advance(referenceProbe, reference, from, middle) == advance(candidateProbe, candidate, from, middle))
+        {
+            good = middle;
+        }
+        else
+        {
+            bad = middle;
+        }
+    }
+    return bad;
+}
+
+// Run Both Engines For The Given Number Of Cycles And Report The First Divergence (If Any)
+DiffResult DiffTester::run(const Chip8 &initialState, unsigned long long cycles)
+{
+    DiffResult result;
+    std::unique_ptr<Chip8> referenceState(new Chip8(initialState));
+    std::unique_ptr<Chip8> candidateState(new Chip8(initialState));
+    referenceState->soundEnabled = false;
+    candidateState->soundEnabled = false;
+
+    // The Last Cycle At Which Both Engines Were Known To Agree
+    std::unique_ptr<Chip8> referenceCheckpoint(new Chip8(*referenceState));
+    std::unique_ptr<Chip8> candidateCheckpoint(new Chip8(*candidateState));
+
+    unsigned long long cycle = 0;
+    while (cycle < cycles)
+    {
+        unsigned long long end = std::min(cycle + compareInterval, cycles);
+        Outcome referenceOutcome = advance(*referenceState, reference, cycle, end);
+        Outcome candidateOutcome = advance(*candidateState, candidate, cycle, end);
+
+        // If The Hashes Differ, Narrow Down The Exact Instruction From The Last Checkpoint
+        if (!(referenceOutcome == candidateOutcome))
+        {
+            unsigned long long first = bisect(*referenceCheckpoint, *candidateCheckpoint, cycle, end);
+
+            // Replay The Reference Up To The Diverging Instruction To Report What It Was
+            Chip8 replay(*referenceCheckpoint);
+            advance(replay, reference, cycle, first - 1);
+
+            result.diverged = true;
+            result.cycle = first - 1;
+            result.pc = replay.pc;
+            result.opcode = (replay.memory[replay.pc & 0x0FFFu] << 8u) | replay.memory[(replay.pc + 1) & 0x0FFFu];
+            result.cyclesRun = first;
+            result.message = "Engines diverged at cycle " + std::to_string(result.cycle) + " (pc " + toHexString(result.pc) + ", opcode " + toHexString(result.opcode) + ")";
+            if (referenceOutcome.faulted != candidateOutcome.faulted)
+            {
+                result.message += ": " + (referenceOutcome.faulted ? "reference" : std::string("candidate")) + " faulted with \"" +
+                                  (referenceOutcome.faulted ? referenceOutcome.message : candidateOutcome.message) + "\"";
+            }
+            return result;
+        }
+
+        // Fold The Checkpoint Into The Rolling Hash
+        result.rollingHash ^= referenceOutcome.hash + 0x9E3779B97F4A7C15ull + (result.rollingHash << 6) + (result.rollingHash >> 2);
+        result.cyclesRun = end;
+
+        // Both Engines Faulted In The Same Way, Which Ends The Run Without A Divergence
+        if (referenceOutcome.faulted)
+        {
+            result.message = "Both engines stopped with \"" + referenceOutcome.message + "\"";
+            return result;
+        }
+
+        referenceCheckpoint.reset(new Chip8(*referenceState));
+        candidateCheckpoint.reset(new Chip8(*candidateState));
+        cycle = end;
+    }
+
+    result.message = "No divergence in " + std::to_string(result.cyclesRun) + " cycles";
+    return result;
+}
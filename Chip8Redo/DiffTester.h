@@ -0,0 +1,75 @@
+#ifndef DIFFTESTER_H
+#define DIFFTESTER_H
+//ensure header is only declared once
+#include <functional> //For Storing The Execution Engines
+#include <string>     //For Engine Names And Fault Messages
+#include <vector>     //For The Input Stream
+#include "Chip8.h"
+
+// A Change To The Keypad That Is Applied Before The Instruction At The Given Cycle Executes
+struct InputEvent
+{
+    unsigned long long cycle;
+    unsigned short keys; // Bit N Set Means Key N Is Pressed
+};
+
+// The Outcome Of A Differential Run
+struct DiffResult
+{
+    bool diverged = false;            // True if the two engines stopped agreeing
+    unsigned long long cycle = 0;     // The first cycle (instruction number) at which the engines disagree
+    unsigned short pc = 0;            // The address of the instruction executed at that cycle
+    unsigned short opcode = 0;        // The instruction executed at that cycle
+    unsigned long long cyclesRun = 0; // How many cycles were compared before stopping
+    unsigned long long rollingHash = 0; // The hash of every compared checkpoint, used as a signature of the whole run
+    std::string message;              // A description of why the run stopped
+};
+
+/*
+Runs The Same Program And Input Stream Through Two Execution Engines In Lockstep
+Every compareInterval cycles the two emulators are compared using Chip8::hashState(),
+and on a mismatch the cycles since the last matching checkpoint are bisected to find the first one that differs
+*/
+class DiffTester
+{
+public:
+    // An Engine Executes A Number Of Instructions On An Emulator, Stopping Early And Reporting Where On A Fault
+    typedef std::function<Chip8::RunResult(Chip8 &, unsigned long long)> Engine;
+
+    // Constructor
+    DiffTester(Engine referenceEngine, Engine candidateEngine);
+
+    // Look Up An Engine By Name (Returns An Empty Engine If The Name Is Unknown)
+    static Engine engine(const std::string &name);
+    // The Names Accepted By engine()
+    static std::vector<std::string> engineNames();
+
+    // Methods
+    void setCompareInterval(unsigned long long instructions);
+    void setInputs(const std::vector<InputEvent> &events);
+    DiffResult run(const Chip8 &initialState, unsigned long long cycles);
+
+private:
+    // The State Of One Engine After Running To A Given Cycle
+    struct Outcome
+    {
+        unsigned long long hash = 0;
+        bool faulted = false;
+        std::string message;
+
+        bool operator==(const Outcome &other) const
+        {
+            return hash == other.hash && faulted == other.faulted && message == other.message;
+        }
+    };
+
+    Outcome advance(Chip8 &emulator, const Engine &engine, unsigned long long from, unsigned long long to) const;
+    unsigned long long bisect(const Chip8 &reference, const Chip8 &candidate, unsigned long long from, unsigned long long to) const;
+
+    Engine reference;
+    Engine candidate;
+    unsigned long long compareInterval = 1000;
+    std::vector<InputEvent> inputs; // Sorted by cycle
+};
+
+#endif // DIFFTESTER_H
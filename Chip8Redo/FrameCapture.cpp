@@ -0,0 +1,179 @@
+#include <chrono>    //For The Encoder Thread Waiting On New Frames
+#include <stdexcept> //For Reporting File Errors
+#include "FrameCapture.h"
+
+//Constructor
+FrameCapture::FrameCapture()
+{
+}
+
+//Destructor
+FrameCapture::~FrameCapture()
+{
+    stop();
+}
+
+// Open The Output File And Start The Encoder Thread
+void FrameCapture::start(const std::string &filename, Format outputFormat, int outputScale, unsigned char red, unsigned char green, unsigned char blue, int framesPerSecond, Upscaler::Filter filter, int phosphorDecay)
+{
+    stop();
+
+    file = std::fopen(filename.c_str(), "wb");
+    if (file == nullptr)
+    {
+        throw std::ios_base::failure("ERROR A problem occurred while attempting to open the capture file " + filename);
+    }
+
+    format = outputFormat;
+    upscaler.setFilter(filter, (outputScale > 0) ? outputScale : 1);
+    persistence = phosphorDecay < Phosphor::MAX_BRIGHTNESS;
+    phosphor.setDecay(phosphorDecay);
+    head = 0;
+    tail = 0;
+    written = 0;
+    dropped = 0;
+    scaledRow.assign(upscaler.width() * 3, 0u);
+
+    unsigned char onColor[3];
+    unsigned char offColor[3];
+    if (format == Y4M)
+    {
+        // Convert The Two Colors To YUV (BT.601, Limited Range) Once, So Each Pixel Is Just A Lookup
+        onColor[0] = static_cast<unsigned char>(16 + (66 * red + 129 * green + 25 * blue + 128) / 256);
+        onColor[1] = static_cast<unsigned char>(128 + (-38 * red - 74 * green + 112 * blue + 128) / 256);
+        onColor[2] = static_cast<unsigned char>(128 + (112 * red - 94 * green - 18 * blue + 128) / 256);
+        offColor[0] = 16;
+        offColor[1] = 128;
+        offColor[2] = 128;
+        std::fprintf(file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", upscaler.width(), upscaler.height(), framesPerSecond);
+    }
+    else
+    {
+        onColor[0] = red;
+        onColor[1] = green;
+        onColor[2] = blue;
+        offColor[0] = offColor[1] = offColor[2] = 0;
+    }
+    // The Levels (Or Brightnesses) In Between Are Blends, Which Mix The Same Way In Either Color Space
+    int brightest = persistence ? Phosphor::MAX_BRIGHTNESS : Upscaler::LIT;
+    for (int value = 0; value <= brightest; value++)
+    {
+        for (int channel = 0; channel < 3; channel++)
+        {
+            palette[value][channel] = static_cast<unsigned char>(offColor[channel] + (onColor[channel] - offColor[channel]) * value / brightest);
+        }
+    }
+
+    running = true;
+    encoder = std::thread(&FrameCapture::encode, this);
+}
+
+// Write Every Queued Frame, Then Close The File
+void FrameCapture::stop()
+{
+    if (encoder.joinable())
+    {
+        running = false;
+        encoder.join();
+    }
+    if (file != nullptr)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+// Pack The Display Into The Next Free Slot, Dropping The Frame If The Encoder Has Fallen Behind
+bool FrameCapture::submit(const Chip8 &emulator)
+{
+    if (!running)
+    {
+        return false;
+    }
+
+    unsigned long long slot = head.load(std::memory_order_relaxed);
+    if (slot - tail.load(std::memory_order_acquire) >= POOL_SIZE)
+    {
+        ++dropped;
+        return false;
+    }
+
+    PackedFrame &frame = pool[slot % POOL_SIZE];
+    for (int y = 0; y < 32; y++)
+    {
+        frame.rows[y] = emulator.video[y];
+    }
+
+    // Publish The Slot To The Encoder
+    head.store(slot + 1, std::memory_order_release);
+    return true;
+}
+
+// The Encoder Thread, Writes Frames Until Stopped And The Queue Is Empty
+void FrameCapture::encode()
+{
+    while (true)
+    {
+        unsigned long long slot = tail.load(std::memory_order_relaxed);
+        if (slot == head.load(std::memory_order_acquire))
+        {
+            if (!running)
+            {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        writeFrame(pool[slot % POOL_SIZE]);
+        ++written;
+        // Hand The Slot Back To The Emulation Thread
+        tail.store(slot + 1, std::memory_order_release);
+    }
+    std::fflush(file);
+}
+
+// Scale And Color One Frame Into The Output File
+void FrameCapture::writeFrame(const PackedFrame &frame)
+{
+    const unsigned char *levels = upscaler.scale(frame.rows);
+    if (persistence)
+    {
+        levels = phosphor.blend(upscaler, frame.rows);
+    }
+    int width = upscaler.width();
+    int height = upscaler.height();
+
+    if (format == Y4M)
+    {
+        std::fputs("FRAME\n", file);
+        // Y4M Is Planar, So The Frame Is Written Once For Each Of The Y, U And V Planes
+        for (int plane = 0; plane < 3; plane++)
+        {
+            for (int y = 0; y < height; y++)
+            {
+                const unsigned char *row = levels + static_cast<size_t>(y) * width;
+                for (int x = 0; x < width; x++)
+                {
+                    scaledRow[x] = palette[row[x]][plane];
+                }
+                std::fwrite(scaledRow.data(), 1, width, file);
+            }
+        }
+    }
+    else
+    {
+        for (int y = 0; y < height; y++)
+        {
+            const unsigned char *row = levels + static_cast<size_t>(y) * width;
+            for (int x = 0; x < width; x++)
+            {
+                const unsigned char *color = palette[row[x]];
+                scaledRow[x * 3] = color[0];
+                scaledRow[x * 3 + 1] = color[1];
+                scaledRow[x * 3 + 2] = color[2];
+            }
+            std::fwrite(scaledRow.data(), 1, width * 3, file);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+//ensure header is only declared once
+#include <atomic>  //For The Lock Free Frame Queue
+#include <cstdio>  //For Writing The Output File
+#include <string>  //For The File Name
+#include <thread>  //For The Encoder Thread
+#include <vector>  //For The Scaled Output Row
+#include "Chip8.h"
+#include "Phosphor.h"
+#include "Upscaler.h"
+
+/*
+Writes The Display To A Video File That ffmpeg Can Read
+The emulation thread only packs the 64 x 32 display into a preallocated slot (one bit per pixel) and moves on,
+a background thread scales (with any of the Upscaler filters, optionally through Phosphor persistence), colors and writes
+each frame, if every slot is full the frame is dropped rather than waiting
+*/
+class FrameCapture
+{
+public:
+    // The Supported Output Formats
+    enum Format
+    {
+        Y4M,   // YUV4MPEG2 4:4:4, ffmpeg -i capture.y4m
+        RawRGB // Packed 24 bit RGB, ffmpeg -f rawvideo -pix_fmt rgb24 -s WxH -r FPS -i capture.rgb
+    };
+
+    // Constructor And Destructor
+    FrameCapture();
+    ~FrameCapture();
+
+    // Methods
+    void start(const std::string &filename, Format format, int scale, unsigned char red, unsigned char green, unsigned char blue, int framesPerSecond = 60, Upscaler::Filter filter = Upscaler::Nearest, int phosphorDecay = Phosphor::MAX_BRIGHTNESS);
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Called Once Per Emulated Frame From The Emulation Thread, Returns False If The Frame Was Dropped
+    bool submit(const Chip8 &emulator);
+
+    unsigned long long framesWritten() const { return written; }
+    unsigned long long framesDropped() const { return dropped; }
+
+private:
+    // One Packed Display, A Bit Per Pixel And A Word Per Row
+    struct PackedFrame
+    {
+        unsigned long long rows[32];
+    };
+
+    void encode();
+    void writeFrame(const PackedFrame &frame);
+
+    // The Frame Pool, Used As A Single Producer / Single Consumer Ring
+    static constexpr unsigned int POOL_SIZE = 16;
+    PackedFrame pool[POOL_SIZE];
+    std::atomic<unsigned long long> head{0}; // next slot the emulation thread fills
+    std::atomic<unsigned long long> tail{0}; // next slot the encoder thread writes
+
+    std::thread encoder;
+    std::atomic<bool> running{false};
+    std::atomic<unsigned long long> written{0};
+    std::atomic<unsigned long long> dropped{0};
+
+    std::FILE *file = nullptr;
+    Format format = Y4M;
+    Upscaler upscaler; // only used by the encoder thread once started
+    Phosphor phosphor;
+    bool persistence = false;
+    unsigned char palette[Phosphor::MAX_BRIGHTNESS + 1][3]{}; // the color of each level (or brightness, with persistence), as RGB or YUV depending on the format
+    std::vector<unsigned char> scaledRow;
+};
+
+#endif // FRAMECAPTURE_H
@@ -0,0 +1,921 @@
+#include <fstream>  //For Reading Input Streams
+#include <iostream> //For Printing Results
+#include <sstream>  //For Splitting Arguments
+#include <cstdlib>  //For Reading Hex Arguments
+#include <thread>   //For Waiting On The Capture Encoder
+#include <chrono>   //For Timing Benchmarks
+#include <algorithm> //For Keeping The Best Benchmark Run
+#include <iterator> //For Reading ROM Bytes
+#include <cstdio>   //For Reopening The Output On The Console
+#include <QCoreApplication>
+#include "BatchChip8.h"
+#include "ControlFlowGraph.h"
+#include "FrameCapture.h"
+#include "Headless.h"
+#include "Recompiler.h"
+#include "RegressionTests.h"
+#include "RunAhead.h"
+#include "StateSearch.h"
+#include "TraceDatabase.h"
+#include "emulationserver.h"
+
+// Read An Input Stream File (One "cycle keymask" Pair Per Line, The Key Mask In Hex)
+std::vector<InputEvent> loadInputs(const std::string &filename)
+{
+    std::ifstream file(filename);
+    if (!file.is_open())
+    {
+        throw std::ios_base::failure("ERROR A problem occurred while attempting to open the input stream " + filename);
+    }
+
+    std::vector<InputEvent> events;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        InputEvent event;
+        if (fields >> event.cycle >> std::hex >> event.keys)
+        {
+            events.push_back(event);
+        }
+    }
+    return events;
+}
+
+// Compare Two Engines On Every ROM Given, Returns The Number Of ROMs That Diverged
+static int runDiff(const std::vector<std::string> &arguments)
+{
+    std::string referenceName = "table";
+    std::string candidateName = "table";
+    unsigned long long cycles = 1000000;
+    unsigned long long interval = 1000;
+    std::vector<InputEvent> inputs;
+    std::vector<std::string> roms;
+
+    for (size_t i = 0; i < arguments.size(); i++)
+    {
+        const std::string &argument = arguments[i];
+        bool hasValue = i + 1 < arguments.size();
+        if (argument == "--engines" && hasValue)
+        {
+            std::string names = arguments[++i];
+            size_t comma = names.find(',');
+            referenceName = names.substr(0, comma);
+            candidateName = (comma == std::string::npos) ? referenceName : names.substr(comma + 1);
+        }
+        else if (argument == "--cycles" && hasValue)
+        {
+            cycles = std::stoull(arguments[++i]);
+        }
+        else if (argument == "--interval" && hasValue)
+        {
+            interval = std::stoull(arguments[++i]);
+        }
+        else if (argument == "--inputs" && hasValue)
+        {
+            inputs = loadInputs(arguments[++i]);
+        }
+        else
+        {
+            roms.push_back(argument);
+        }
+    }
+
+    DiffTester::Engine reference = DiffTester::engine(referenceName);
+    DiffTester::Engine candidate = DiffTester::engine(candidateName);
+    if (!reference || !candidate)
+    {
+        std::cerr << "Unknown engine, expected one of:";
+        for (const std::string &name : DiffTester::engineNames())
+        {
+            std::cerr << " " << name;
+        }
+        std::cerr << "\n";
+        return -1;
+    }
+
+    DiffTester tester(reference, candidate);
+    tester.setCompareInterval(interval);
+    tester.setInputs(inputs);
+
+    int divergences = 0;
+    for (const std::string &rom : roms)
+    {
+        Chip8 emulator;
+        emulator.seedRandom(1u); // both engines start from the same seed on every run
+        emulator.loadProgram(rom.c_str());
+
+        DiffResult result = tester.run(emulator, cycles);
+        std::cout << (result.diverged ? "DIVERGED " : "OK       ") << rom << ": " << result.message
+                  << " [signature " << std::hex << result.rollingHash << std::dec << "]\n";
+        if (result.diverged)
+        {
+            ++divergences;
+        }
+    }
+    return divergences;
+}
+
+/* Time "laneCount" Copies Of A Program As BatchChip8 Lanes Against The Same Copies Run One After Another With Chip8::run()
+With "sameInput" every copy stays in lockstep, otherwise each has its own random seed and holds its own key so they diverge like
+separate players, and "cycles" instructions are shared out between the copies*/
+static void benchLanes(const std::string &rom, const Chip8 &initial, size_t laneCount, unsigned long long cycles, int repeats, bool sameInput)
+{
+    std::vector<Chip8> copies(laneCount, initial);
+    for (size_t lane = 0; lane < laneCount && !sameInput; lane++)
+    {
+        copies[lane].seedRandom(static_cast<unsigned int>(lane + 1));
+        copies[lane].setKeys(static_cast<unsigned short>(1u << (lane % 16)));
+    }
+    unsigned long long steps = std::max(1ull, cycles / laneCount);
+
+    double batchBest = 0.0;
+    double scalarBest = 0.0;
+    for (int repeat = 0; repeat < repeats; repeat++)
+    {
+        BatchChip8 batch(laneCount);
+        for (size_t lane = 0; lane < laneCount; lane++)
+        {
+            batch.loadLane(lane, copies[lane]);
+        }
+        auto start = std::chrono::steady_clock::now();
+        batch.run(steps);
+        std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        unsigned long long executed = 0;
+        for (size_t lane = 0; lane < laneCount; lane++)
+        {
+            executed += batch.cycle(lane) - copies[lane].cycle;
+        }
+        if (seconds.count() > 0.0)
+        {
+            batchBest = std::max(batchBest, executed / seconds.count() / 1e6);
+        }
+
+        std::vector<Chip8> emulators = copies;
+        start = std::chrono::steady_clock::now();
+        executed = 0;
+        for (Chip8 &emulator : emulators)
+        {
+            executed += emulator.run(steps).executed;
+        }
+        seconds = std::chrono::steady_clock::now() - start;
+        if (seconds.count() > 0.0)
+        {
+            scalarBest = std::max(scalarBest, executed / seconds.count() / 1e6);
+        }
+    }
+    std::cout << rom << " " << laneCount << " lanes, " << (sameInput ? "same input" : "different inputs") << ": BatchChip8 " << batchBest
+              << " MIPS, " << laneCount << " x Chip8::run() " << scalarBest << " MIPS\n";
+}
+
+// Time Each Engine On Every ROM Given, Printing Millions Of Instructions Per Second (The Best Of Several Runs)
+static int runBench(const std::vector<std::string> &arguments)
+{
+    std::vector<std::string> engineNames = {"table", "run", "predecoded"};
+    unsigned long long cycles = 10000000;
+    int repeats = 3;
+    size_t laneCount = 0;
+    std::vector<std::string> roms;
+
+    for (size_t i = 0; i < arguments.size(); i++)
+    {
+        const std::string &argument = arguments[i];
+        bool hasValue = i + 1 < arguments.size();
+        if (argument == "--engines" && hasValue)
+        {
+            engineNames.clear();
+            std::istringstream names(arguments[++i]);
+            std::string name;
+            while (std::getline(names, name, ','))
+            {
+                engineNames.push_back(name);
+            }
+        }
+        else if (argument == "--cycles" && hasValue)
+        {
+            cycles = std::stoull(arguments[++i]);
+        }
+        else if (argument == "--repeat" && hasValue)
+        {
+            repeats = std::max(1, std::stoi(arguments[++i]));
+        }
+        else if (argument == "--lanes" && hasValue)
+        {
+            laneCount = std::stoul(arguments[++i]);
+        }
+        else
+        {
+            roms.push_back(argument);
+        }
+    }
+
+    std::vector<DiffTester::Engine> engines;
+    for (const std::string &name : engineNames)
+    {
+        engines.push_back(DiffTester::engine(name));
+        if (!engines.back())
+        {
+            std::cerr << "Unknown engine " << name << "\n";
+            return -1;
+        }
+    }
+    if (roms.empty())
+    {
+        std::cerr << "Usage: --bench [--engines name,name,...] [--cycles N] [--repeat N] [--lanes K] rom...\n";
+        return -1;
+    }
+
+    // "run" Is The Batched Loop, Which Is Built With One Of Two Dispatchers (See Chip8.cpp)
+    std::cout << "run() dispatch: " << Chip8::runDispatch() << "\n";
+    for (const std::string &rom : roms)
+    {
+        Chip8 initial;
+        initial.seedRandom(1u);
+        initial.soundEnabled = false;
+        initial.loadProgram(rom.c_str());
+
+        for (size_t e = 0; e < engines.size(); e++)
+        {
+            double best = 0.0;
+            Chip8::RunResult result;
+            for (int repeat = 0; repeat < repeats; repeat++)
+            {
+                Chip8 emulator = initial;
+                auto start = std::chrono::steady_clock::now();
+                result = engines[e](emulator, cycles);
+                std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+                if (seconds.count() > 0.0)
+                {
+                    best = std::max(best, result.executed / seconds.count() / 1e6);
+                }
+            }
+            std::cout << rom << " " << engineNames[e] << ": " << best << " MIPS";
+            if (!result.ok())
+            {
+                std::cout << " (stopped after " << result.executed << " instructions: " << Chip8::faultMessage(result.fault, result.opcode) << ")";
+            }
+            std::cout << "\n";
+        }
+        if (laneCount > 0)
+        {
+            benchLanes(rom, initial, laneCount, cycles, repeats, true);
+            benchLanes(rom, initial, laneCount, cycles, repeats, false);
+        }
+    }
+    return 0;
+}
+
+// Search For Keypad Input That Reaches A Goal, Printing It As An Input Stream For --diff And --capture
+static int runSearch(const std::vector<std::string> &arguments)
+{
+    SearchOptions options;
+    SearchGoal goal;
+    int targetPc = -1;
+    std::string rom;
+
+    for (size_t i = 0; i < arguments.size(); i++)
+    {
+        const std::string &argument = arguments[i];
+        bool hasValue = i + 1 < arguments.size();
+        if (argument == "--pc" && hasValue)
+        {
+            targetPc = static_cast<int>(std::strtoul(arguments[++i].c_str(), nullptr, 16));
+            goal = StateSearch::reachPc(static_cast<unsigned short>(targetPc));
+        }
+        else if (argument == "--memory" && hasValue)
+        {
+            // Given As address=value, Both In Hex
+            std::string pair = arguments[++i];
+            size_t equals = pair.find('=');
+            unsigned long address = std::strtoul(pair.substr(0, equals).c_str(), nullptr, 16);
+            unsigned long value = (equals == std::string::npos) ? 0 : std::strtoul(pair.substr(equals + 1).c_str(), nullptr, 16);
+            goal = StateSearch::memoryEquals(static_cast<unsigned short>(address), static_cast<unsigned char>(value));
+        }
+        else if (argument == "--depth" && hasValue)
+        {
+            options.maxDepth = std::stoul(arguments[++i]);
+        }
+        else if (argument == "--beam" && hasValue)
+        {
+            options.beamWidth = std::stoul(arguments[++i]);
+        }
+        else if (argument == "--frame" && hasValue)
+        {
+            options.instructionsPerFrame = std::stoul(arguments[++i]);
+        }
+        else if (argument == "--threads" && hasValue)
+        {
+            options.threads = std::stoul(arguments[++i]);
+        }
+        else if (argument == "--max-states" && hasValue)
+        {
+            options.maxStates = std::stoull(arguments[++i]);
+        }
+        else
+        {
+            rom = argument;
+        }
+    }
+
+    if (!goal || rom.empty())
+    {
+        std::cerr << "Usage: --search (--pc address | --memory address=value) [--depth N] [--beam N] [--frame N] [--threads N] [--max-states N] rom\n";
+        return -1;
+    }
+
+    Chip8 emulator;
+    emulator.seedRandom(1u);
+    emulator.loadProgram(rom.c_str());
+
+    StateSearch search(goal, options);
+    // Beam Search Toward An Address Prefers States Whose Program Counter Is Closest To It
+    if (targetPc >= 0)
+    {
+        search.setScore([targetPc](const Chip8 &state)
+                        { return -std::abs(static_cast<int>(state.pc) - targetPc); });
+    }
+
+    SearchResult result = search.run(emulator);
+    std::cerr << result.message << ": " << result.statesVisited << " states, " << result.duplicates << " duplicates, "
+              << result.faults << " faults, " << result.framesEmulated << " frames in " << result.seconds << "s ("
+              << (result.seconds > 0 ? result.framesEmulated / result.seconds : 0) << " frames/s)\n";
+
+    // Print The Winning Inputs In The Format loadInputs() Reads
+    for (size_t frame = 0; frame < result.inputs.size(); frame++)
+    {
+        std::cout << frame * options.instructionsPerFrame << " " << std::hex << result.inputs[frame] << std::dec << "\n";
+    }
+    return result.found ? 0 : 1;
+}
+
+// Replay A ROM (And Optionally An Input Stream) Into A Video File
+static int runCapture(const std::vector<std::string> &arguments)
+{
+    unsigned long long frames = 600;
+    unsigned int instructionsPerFrame = 100;
+    int scale = 10;
+    unsigned long color = 0xFFFFFF;
+    FrameCapture::Format format = FrameCapture::Y4M;
+    Upscaler::Filter filter = Upscaler::Nearest;
+    int phosphorDecay = Phosphor::MAX_BRIGHTNESS;
+    std::vector<InputEvent> inputs;
+    std::vector<std::string> files;
+
+    for (size_t i = 0; i < arguments.size(); i++)
+    {
+        const std::string &argument = arguments[i];
+        bool hasValue = i + 1 < arguments.size();
+        if (argument == "--frames" && hasValue)
+        {
+            frames = std::stoull(arguments[++i]);
+        }
+        else if (argument == "--frame" && hasValue)
+        {
+            instructionsPerFrame = std::stoul(arguments[++i]);
+        }
+        else if (argument == "--scale" && hasValue)
+        {
+            scale = std::stoi(arguments[++i]);
+        }
+        else if (argument == "--color" && hasValue)
+        {
+            color = std::strtoul(arguments[++i].c_str(), nullptr, 16);
+        }
+        else if (argument == "--format" && hasValue)
+        {
+            format = (arguments[++i] == "rgb") ? FrameCapture::RawRGB : FrameCapture::Y4M;
+        }
+        else if (argument == "--inputs" && hasValue)
+        {
+            inputs = loadInputs(arguments[++i]);
+        }
+        else if (argument == "--phosphor" && hasValue)
+        {
+            phosphorDecay = std::stoi(arguments[++i]);
+        }
+        else if (argument == "--filter" && hasValue)
+        {
+            if (!Upscaler::filterNamed(arguments[++i], filter))
+            {
+                std::cerr << "Unknown filter " << arguments[i] << "\n";
+                return -1;
+            }
+        }
+        else
+        {
+            files.push_back(argument);
+        }
+    }
+
+    if (files.size() != 2)
+    {
+        std::cerr << "Usage: --capture [--frames N] [--frame N] [--scale N] [--filter nearest|scale2x|scale3x|hq2x] [--phosphor decay] [--color RRGGBB] [--format y4m|rgb] [--inputs file] rom output\n";
+        return -1;
+    }
+
+    Chip8 emulator;
+    emulator.seedRandom(1u);
+    emulator.soundEnabled = false;
+    emulator.loadProgram(files[0].c_str());
+
+    FrameCapture capture;
+    capture.start(files[1], format, scale, (color >> 16u) & 0xFFu, (color >> 8u) & 0xFFu, color & 0xFFu, 60, filter, phosphorDecay);
+
+    unsigned long long cycle = 0;
+    size_t nextInput = 0;
+    Chip8::RunResult result;
+    for (unsigned long long frame = 0; frame < frames && result.ok(); frame++)
+    {
+        // Run Up To Each Input Event In The Frame, Skipping Through Idle Loops On The Way
+        unsigned long long frameEnd = cycle + instructionsPerFrame;
+        while (cycle < frameEnd && result.ok())
+        {
+            while (nextInput < inputs.size() && inputs[nextInput].cycle <= cycle)
+            {
+                emulator.setKeys(inputs[nextInput++].keys);
+            }
+            unsigned long long stop = (nextInput < inputs.size() && inputs[nextInput].cycle < frameEnd) ? inputs[nextInput].cycle : frameEnd;
+            result = emulator.runInstructions(stop - cycle);
+            cycle = stop;
+        }
+        // An Offline Capture Should Keep Every Frame, So Wait For A Free Slot Instead Of Dropping
+        while (result.ok() && !capture.submit(emulator))
+        {
+            std::this_thread::yield();
+        }
+        ++emulator.counters.frames;
+    }
+    if (!result.ok())
+    {
+        std::cerr << Chip8::faultMessage(result.fault, result.opcode) << " (cycle " << emulator.cycle << ", pc 0x" << std::hex << result.pc << std::dec << ")\n";
+    }
+
+    capture.stop();
+    std::cerr << capture.framesWritten() << " frames written to " << files[1] << "\n";
+    PerformanceCounters::Totals counters = emulator.performance();
+    std::cerr << counters.instructions << " instructions, " << counters.draws << " draws (" << counters.pixelsToggled << " pixels, "
+              << counters.collisions << " collisions), " << counters.timerTicks << " timer ticks, " << counters.keyWaitCycles << " key wait cycles\n";
+    return 0;
+}
+
+// Print A Labelled Disassembly Of A ROM, And Optionally Write Its Control Flow Graph For Graphviz
+static int runAnalyze(const std::vector<std::string> &arguments)
+{
+    std::string dotFilename;
+    std::vector<std::string> roms;
+
+    for (size_t i = 0; i < arguments.size(); i++)
+    {
+        const std::string &argument = arguments[i];
+        if (argument == "--dot" && i + 1 < arguments.size())
+        {
+            dotFilename = arguments[++i];
+        }
+        else
+        {
+            roms.push_back(argument);
+        }
+    }
+
+    if (roms.size() != 1)
+    {
+        std::cerr << "Usage: --analyze [--dot file] rom\n";
+        return -1;
+    }
+
+    Chip8 emulator;
+    emulator.loadProgram(roms[0].c_str());
+    ControlFlowGraph graph(emulator);
+    std::cout << graph.text();
+
+    if (!dotFilename.empty())
+    {
+        std::ofstream dot(dotFilename);
+        if (!dot.is_open())
+        {
+            throw std::ios_base::failure("ERROR A problem occurred while attempting to open the file " + dotFilename);
+        }
+        dot << graph.graphviz();
+    }
+    return 0;
+}
+
+// Recompile A ROM Into A C++ Source File (See Recompiler.h)
+static int runRecompile(const std::vector<std::string> &arguments)
+{
+    bool withMain = false;
+    std::vector<std::string> files;
+
+    for (const std::string &argument : arguments)
+    {
+        if (argument == "--main")
+        {
+            withMain = true;
+        }
+        else
+        {
+            files.push_back(argument);
+        }
+    }
+
+    if (files.size() != 2)
+    {
+        std::cerr << "Usage: --recompile [--main] rom output.cpp\n";
+        return -1;
+    }
+
+    std::ifstream romFile(files[0], std::ios::binary);
+    if (!romFile.is_open())
+    {
+        throw std::ios_base::failure("ERROR A problem occurred while attempting to open the file " + files[0]);
+    }
+    std::vector<unsigned char> rom((std::istreambuf_iterator<char>(romFile)), std::istreambuf_iterator<char>());
+
+    Recompiler recompiler(rom);
+    std::ofstream output(files[1]);
+    if (!output.is_open())
+    {
+        throw std::ios_base::failure("ERROR A problem occurred while attempting to open the file " + files[1]);
+    }
+    output << recompiler.source(files[0], withMain);
+
+    std::cerr << files[0] << ": " << recompiler.segmentCount() << " segments, " << recompiler.instructionCount()
+              << " instructions recompiled, " << recompiler.interpretedCount() << " left to the interpreter\n";
+    return 0;
+}
+
+// Time Run-Ahead (See RunAhead.h): Every Displayed Frame Takes A Save State And Runs "ahead" + 1 Frames, Which Must Fit In A 60th Of A Second
+static int runRunAhead(const std::vector<std::string> &arguments)
+{
+    unsigned int ahead = 2;
+    unsigned long long instructionsPerFrame = 100;
+    unsigned long long frames = 3600;
+    std::vector<InputEvent> inputs;
+    std::string rom;
+
+    for (size_t i = 0; i < arguments.size(); i++)
+    {
+        const std::string &argument = arguments[i];
+        bool hasValue = i + 1 < arguments.size();
+        if (argument == "--ahead" && hasValue)
+        {
+            ahead = std::stoul(arguments[++i]);
+        }
+        else if (argument == "--frame" && hasValue)
+        {
+            instructionsPerFrame = std::max(1ull, std::stoull(arguments[++i]));
+        }
+        else if (argument == "--frames" && hasValue)
+        {
+            frames = std::stoull(arguments[++i]);
+        }
+        else if (argument == "--inputs" && hasValue)
+        {
+            inputs = loadInputs(arguments[++i]);
+        }
+        else
+        {
+            rom = argument;
+        }
+    }
+
+    if (rom.empty() || frames == 0)
+    {
+        std::cerr << "Usage: --runahead [--ahead N] [--frame N] [--frames N] [--inputs file] rom\n";
+        return -1;
+    }
+
+    Chip8 emulator;
+    emulator.seedRandom(1u);
+    emulator.soundEnabled = false;
+    emulator.loadProgram(rom.c_str());
+
+    // The Save State On Its Own, Averaged Over Many Copies Since One Takes Well Under A Microsecond
+    RunAhead runAhead;
+    static constexpr int SAVE_STATES = 100000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SAVE_STATES; i++)
+    {
+        runAhead.lookAhead(emulator, 0, instructionsPerFrame);
+    }
+    double saveStateMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / SAVE_STATES;
+
+    // Every Displayed Frame, Timed From The Save State To The End Of The Real Frame
+    std::vector<double> frameMicroseconds;
+    size_t nextInput = 0;
+    Chip8::RunResult result;
+    for (unsigned long long frame = 0; frame < frames && result.ok(); frame++)
+    {
+        while (nextInput < inputs.size() && inputs[nextInput].cycle <= emulator.cycle)
+        {
+            emulator.setKeys(inputs[nextInput++].keys);
+        }
+        start = std::chrono::steady_clock::now();
+        result = runAhead.runFrame(emulator, ahead, instructionsPerFrame);
+        frameMicroseconds.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    if (!result.ok())
+    {
+        std::cerr << Chip8::faultMessage(result.fault, result.opcode) << " (cycle " << emulator.cycle << ", pc 0x" << std::hex << result.pc << std::dec << ")\n";
+    }
+
+    std::sort(frameMicroseconds.begin(), frameMicroseconds.end());
+    double total = 0.0;
+    for (double microseconds : frameMicroseconds)
+    {
+        total += microseconds;
+    }
+    double mean = total / frameMicroseconds.size();
+    double slowest = frameMicroseconds.back();
+    double budget = 1e6 / 60.0;
+    std::cout << rom << ": " << frameMicroseconds.size() << " displayed frames, " << ahead << " frames ahead of " << instructionsPerFrame << " instructions\n"
+              << "  save state " << saveStateMicroseconds << " us\n"
+              << "  " << ahead + 1 << " frames per displayed frame: mean " << mean << " us, 99% "
+              << frameMicroseconds[std::min(frameMicroseconds.size() - 1, frameMicroseconds.size() * 99 / 100)] << " us, worst " << slowest << " us\n"
+              << "  budget " << budget << " us, the worst frame uses " << 100.0 * slowest / budget << "% of it"
+              << " (about " << static_cast<unsigned long long>(budget / std::max(mean / (ahead + 1), 1e-3)) << " frames would fit on average)\n";
+    return (slowest <= budget) ? 0 : 1;
+}
+
+// Record A ROM Into A Trace Database, Then Time Questions About Its History (See TraceDatabase::query())
+static int runTrace(const std::vector<std::string> &arguments)
+{
+    unsigned long long cycles = 10000000;
+    unsigned long long before = static_cast<unsigned long long>(-1);
+    size_t limit = 8;
+    std::vector<InputEvent> inputs;
+    std::string rom;
+    std::vector<std::string> queries;
+
+    for (size_t i = 0; i < arguments.size(); i++)
+    {
+        const std::string &argument = arguments[i];
+        bool hasValue = i + 1 < arguments.size();
+        if (argument == "--cycles" && hasValue)
+        {
+            cycles = std::stoull(arguments[++i]);
+        }
+        else if (argument == "--before" && hasValue)
+        {
+            before = std::stoull(arguments[++i]);
+        }
+        else if (argument == "--limit" && hasValue)
+        {
+            limit = std::stoul(arguments[++i]);
+        }
+        else if (argument == "--inputs" && hasValue)
+        {
+            inputs = loadInputs(arguments[++i]);
+        }
+        else if (rom.empty())
+        {
+            rom = argument;
+        }
+        else
+        {
+            queries.push_back(argument);
+        }
+    }
+
+    if (rom.empty())
+    {
+        std::cerr << "Usage: --trace [--cycles N] [--before N] [--limit N] [--inputs file] rom query...   (a query such as \"V3\", \"I 2A0\", \"PC 2A0\", \"M 300\" or \"DRAW 10 5\")\n";
+        return -1;
+    }
+
+    Chip8 emulator;
+    emulator.seedRandom(1u);
+    emulator.soundEnabled = false;
+    emulator.loadProgram(rom.c_str());
+
+    TraceDatabase trace;
+    size_t nextInput = 0;
+    Chip8::Fault fault = Chip8::NoFault;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long long i = 0; i < cycles && fault == Chip8::NoFault; i++)
+    {
+        while (nextInput < inputs.size() && inputs[nextInput].cycle <= emulator.cycle)
+        {
+            emulator.setKeys(inputs[nextInput++].keys);
+        }
+        fault = trace.step(emulator);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (fault != Chip8::NoFault)
+    {
+        std::cerr << Chip8::faultMessage(fault, emulator.opcode) << " (cycle " << emulator.cycle << ")\n";
+    }
+    unsigned long long recorded = trace.endCycle() - trace.firstCycle();
+    std::cout << rom << ": recorded " << recorded << " instructions in " << seconds << " s (" << recorded / std::max(seconds, 1e-9) / 1e6
+              << " million per second), " << trace.memoryUsage() / (1024.0 * 1024.0) << " MB ("
+              << static_cast<double>(trace.memoryUsage()) / std::max(recorded, 1ull) << " bytes per instruction)\n";
+
+    // Each Question Is Asked Many Times, Since One Answer Takes A Few Microseconds
+    static constexpr int REPEATS = 1000;
+    before = std::min(before, trace.endCycle());
+    for (const std::string &query : queries)
+    {
+        std::string error;
+        std::vector<TraceDatabase::Hit> hits;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < REPEATS; i++)
+        {
+            hits = trace.query(query, before, limit, error);
+        }
+        double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / REPEATS;
+        if (!error.empty())
+        {
+            std::cerr << query << ": " << error << "\n";
+            return -1;
+        }
+        std::cout << query << ": " << hits.size() << " latest before cycle " << before << " in " << microseconds << " us\n";
+        for (const TraceDatabase::Hit &hit : hits)
+        {
+            std::cout << "  " << hit.text << "\n";
+        }
+    }
+
+    // Travelling Back Restores A Checkpoint And Replays Up To It
+    if (recorded > 0)
+    {
+        Chip8 past;
+        past.soundEnabled = false;
+        static constexpr int SEEKS = 100;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < SEEKS; i++)
+        {
+            trace.seek(past, trace.firstCycle() + recorded * i / SEEKS);
+        }
+        std::cout << "seek " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / SEEKS << " ms on average\n";
+    }
+    return (fault == Chip8::NoFault) ? 0 : 1;
+}
+
+// Run Every Regression Test Through Each Engine, Returns The Number Of Failures
+static int runRegress(const std::vector<std::string> &arguments)
+{
+    std::vector<std::string> engineNames = DiffTester::engineNames();
+
+    for (size_t i = 0; i < arguments.size(); i++)
+    {
+        if (arguments[i] == "--engines" && i + 1 < arguments.size())
+        {
+            engineNames.clear();
+            std::istringstream names(arguments[++i]);
+            std::string name;
+            while (std::getline(names, name, ','))
+            {
+                engineNames.push_back(name);
+            }
+        }
+        else
+        {
+            std::cerr << "Usage: --regress [--engines name,name,...]\n";
+            return -1;
+        }
+    }
+
+    std::vector<RegressionTest> tests = regressionTests();
+    int failures = 0;
+    for (const std::string &name : engineNames)
+    {
+        DiffTester::Engine engine = DiffTester::engine(name);
+        if (!engine)
+        {
+            std::cerr << "Unknown engine " << name << "\n";
+            return -1;
+        }
+        for (const RegressionTest &test : tests)
+        {
+            std::string failure = runRegressionTest(test, engine);
+            if (!failure.empty())
+            {
+                std::cout << "FAILED " << name << ": " << test.name << ": " << failure << "\n";
+                ++failures;
+            }
+        }
+    }
+    std::cout << tests.size() * engineNames.size() - failures << " of " << tests.size() * engineNames.size() << " passed\n";
+    return failures;
+}
+
+// Host A Pool Of Emulators For Other Processes Until Killed
+static int runServer(int argc, char *argv[], const std::vector<std::string> &arguments)
+{
+    QString name = "chip8";
+    int maxInstances = 4096;
+    for (size_t i = 0; i + 1 < arguments.size(); i++)
+    {
+        if (arguments[i] == "--name")
+        {
+            name = QString::fromStdString(arguments[++i]);
+        }
+        else if (arguments[i] == "--instances")
+        {
+            maxInstances = std::stoi(arguments[++i]);
+        }
+    }
+
+    QCoreApplication application(argc, argv);
+    EmulationServer server(maxInstances);
+    if (!server.listen(name))
+    {
+        std::cerr << "Could not start the server: " << server.errorString().toStdString() << "\n";
+        return -1;
+    }
+    std::cerr << "Serving up to " << maxInstances << " emulators on \"" << name.toStdString() << "\"\n";
+    return application.exec();
+}
+
+// Print To The Console That Started The Program
+// The Program Is Built As A Windows GUI Application So The Window Opens Without A Console, Which Leaves std::cout And std::cerr
+// Going Nowhere, So A Command Line Tool Attaches To Its Parent's Console (If It Was Started From One) And Reopens Them On It
+static void attachConsole()
+{
+#ifdef _WIN32
+    if (AttachConsole(ATTACH_PARENT_PROCESS))
+    {
+        std::freopen("CONOUT$", "w", stdout);
+        std::freopen("CONOUT$", "w", stderr);
+        std::cout.clear();
+        std::cerr.clear();
+    }
+#endif
+}
+
+// Run The Command Given On The Command Line
+bool runHeadless(int argc, char *argv[], int &exitCode)
+{
+    if (argc < 2)
+    {
+        return false;
+    }
+
+    std::string command = argv[1];
+    std::vector<std::string> arguments(argv + 2, argv + argc);
+    if (command.compare(0, 2, "--") == 0)
+    {
+        attachConsole();
+    }
+
+    try
+    {
+        if (command == "--diff")
+        {
+            exitCode = runDiff(arguments);
+            return true;
+        }
+        if (command == "--bench")
+        {
+            exitCode = runBench(arguments);
+            return true;
+        }
+        if (command == "--search")
+        {
+            exitCode = runSearch(arguments);
+            return true;
+        }
+        if (command == "--capture")
+        {
+            exitCode = runCapture(arguments);
+            return true;
+        }
+        if (command == "--analyze")
+        {
+            exitCode = runAnalyze(arguments);
+            return true;
+        }
+        if (command == "--recompile")
+        {
+            exitCode = runRecompile(arguments);
+            return true;
+        }
+        if (command == "--runahead")
+        {
+            exitCode = runRunAhead(arguments);
+            return true;
+        }
+        if (command == "--trace")
+        {
+            exitCode = runTrace(arguments);
+            return true;
+        }
+        if (command == "--regress")
+        {
+            exitCode = runRegress(arguments);
+            return true;
+        }
+        if (command == "--serve")
+        {
+            exitCode = runServer(argc, argv, arguments);
+            return true;
+        }
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << error.what() << "\n";
+        exitCode = -1;
+        return true;
+    }
+    return false;
+}
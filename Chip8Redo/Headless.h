@@ -0,0 +1,28 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+//ensure header is only declared once
+#include <string>
+#include <vector>
+#include "DiffTester.h"
+
+/*
+Command Line Tools That Run The Emulator Without Opening The Window
+Chip8Redo --diff [--engines reference,candidate] [--cycles N] [--interval N] [--inputs file] rom...
+Chip8Redo --bench [--engines name,name,...] [--cycles N] [--repeat N] [--lanes K] rom...   (instructions per second of each engine, --lanes also times K BatchChip8 lanes against K Chip8s)
+Chip8Redo --search (--pc address | --memory address=value) [--depth N] [--beam N] [--frame N] [--threads N] rom
+Chip8Redo --capture [--frames N] [--frame N] [--scale N] [--color RRGGBB] [--format y4m|rgb] [--inputs file] rom output
+Chip8Redo --analyze [--dot file] rom   (prints a disassembly listing, --dot also writes the control flow graph)
+Chip8Redo --recompile [--main] rom output.cpp   (C++ for the ROM, see Recompiler.h, --main adds a main() that times it and checks it against the interpreter)
+Chip8Redo --runahead [--ahead N] [--frame N] [--frames N] [--inputs file] rom   (times run-ahead against a 60th of a second per frame)
+Chip8Redo --trace [--cycles N] [--before N] [--limit N] [--inputs file] rom query...   (records a trace and times questions about it, see TraceDatabase.h)
+Chip8Redo --regress [--engines name,name,...]   (runs every test in RegressionTests.cpp through each engine)
+Chip8Redo --serve [--name name] [--instances N]   (see emulationserver.h for the protocol)
+*/
+
+// Run The Command Given On The Command Line, Returns False If The Arguments Are Not A Headless Command
+bool runHeadless(int argc, char *argv[], int &exitCode);
+
+// Read An Input Stream File (One "cycle keymask" Pair Per Line, The Key Mask In Hex)
+std::vector<InputEvent> loadInputs(const std::string &filename);
+
+#endif // HEADLESS_H
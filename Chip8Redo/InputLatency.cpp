@@ -0,0 +1,96 @@
+#include <chrono> //For Timestamps
+#include "InputLatency.h"
+
+//Constructor
+InputLatency::InputLatency()
+    : pendingSince(0)
+{
+    reset();
+}
+
+// Steady Clock Time In Nanoseconds (Never 0, Which Means "No Event" In pendingSince)
+long long InputLatency::now()
+{
+    long long time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    return (time != 0) ? time : 1;
+}
+
+// Timestamp A Key Event, Unless An Earlier One Is Still Waiting To Be Observed
+void InputLatency::keyEvent()
+{
+    long long none = 0;
+    pendingSince.compare_exchange_strong(none, now(), std::memory_order_acq_rel);
+}
+
+// Add The Time Since The Pending Key Event To The Histogram
+void InputLatency::record()
+{
+    long long since = pendingSince.exchange(0, std::memory_order_acq_rel);
+    if (since == 0)
+    {
+        return;
+    }
+
+    unsigned long long microseconds = static_cast<unsigned long long>(now() - since) / 1000u;
+    int bucket = 0;
+    while (bucket < BUCKETS - 1 && microseconds >= (1ull << bucket))
+    {
+        ++bucket;
+    }
+    counts[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<unsigned long long> InputLatency::histogram() const
+{
+    std::vector<unsigned long long> copy(BUCKETS);
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        copy[i] = counts[i].load(std::memory_order_relaxed);
+    }
+    return copy;
+}
+
+unsigned long long InputLatency::samples() const
+{
+    unsigned long long total = 0;
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        total += counts[i].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+double InputLatency::percentile(double fraction) const
+{
+    std::vector<unsigned long long> copy = histogram();
+    unsigned long long total = 0;
+    for (unsigned long long count : copy)
+    {
+        total += count;
+    }
+    if (total == 0)
+    {
+        return 0.0;
+    }
+
+    unsigned long long target = static_cast<unsigned long long>(fraction * total);
+    unsigned long long seen = 0;
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        seen += copy[i];
+        if (seen > target)
+        {
+            return bucketLimit(i);
+        }
+    }
+    return bucketLimit(BUCKETS - 1);
+}
+
+void InputLatency::reset()
+{
+    for (int i = 0; i < BUCKETS; i++)
+    {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+    pendingSince.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,49 @@
+#ifndef INPUTLATENCY_H
+#define INPUTLATENCY_H
+//ensure header is only declared once
+#include <atomic> //For Sharing The Measurements Between Threads
+#include <vector> //For Copying The Histogram Out
+
+/*
+Measures How Long A Key Event Takes To Reach The Program
+The GUI calls keyEvent() as each key is pressed or released, and the emulator calls observed() whenever an instruction reads
+the keypad (Ex9E, ExA1 or Fx0A). The time from the oldest key event nobody has observed yet to the instruction that observes it
+is added to a histogram with one bucket per power of two microseconds.
+*/
+class InputLatency
+{
+public:
+    static constexpr int BUCKETS = 24; // bucket N holds latencies from 2^(N-1) up to 2^N microseconds, the last holds everything longer
+
+    // Constructor
+    InputLatency();
+
+    // Called By The GUI When A Key Changes
+    void keyEvent();
+    // Called By The Emulator When An Instruction Reads The Keypad
+    void observed()
+    {
+        if (pendingSince.load(std::memory_order_relaxed) != 0)
+        {
+            record();
+        }
+    }
+
+    // The Measurements So Far
+    std::vector<unsigned long long> histogram() const;
+    unsigned long long samples() const;
+    double percentile(double fraction) const; // the upper edge of the bucket holding that fraction of samples, in microseconds
+    void reset();
+
+    // The Upper Edge Of A Bucket In Microseconds
+    static double bucketLimit(int bucket) { return static_cast<double>(1ull << bucket); }
+
+private:
+    void record();
+    static long long now();
+
+    std::atomic<long long> pendingSince; // when the oldest unobserved key event happened (steady clock nanoseconds), 0 if none
+    std::atomic<unsigned long long> counts[BUCKETS];
+};
+
+#endif // INPUTLATENCY_H
@@ -0,0 +1,79 @@
+#ifndef PERFORMANCECOUNTERS_H
+#define PERFORMANCECOUNTERS_H
+//ensure header is only declared once
+
+/*
+Counts What An Emulator Has Done Since Its Program Was Loaded (Or The Counters Were Reset)
+Every count is one add in code that already runs rarely (drawing, key waits, faults), so nothing is added to the instruction loop.
+Two counts are worked out when they are read instead: the instructions retired come from Chip8::cycle, and the timer ticks from
+the timers themselves, since a timer only ever counts down between being set, the ticks since it was last set are the value it was
+set to less what is left. Anything that sets a timer must note it with setDelay() or setSound().
+The counters are part of the emulator, so copies, snapshots and the instances of a Chip8Pool each carry their own.
+*/
+struct PerformanceCounters
+{
+    // The Counts As Read By Chip8::performance()
+    struct Totals
+    {
+        unsigned long long instructions = 0u;  // instructions retired, skipped idle instructions included
+        unsigned long long frames = 0u;        // display frames (60ths of a second) the program has run for
+        unsigned long long draws = 0u;         // Dxyn instructions
+        unsigned long long pixelsToggled = 0u; // set sprite pixels drawn, each one flips a pixel of the display
+        unsigned long long collisions = 0u;    // draws that turned a pixel off (set VF)
+        unsigned long long timerTicks = 0u;    // times the delay or sound timer counted down
+        unsigned long long keyWaitCycles = 0u; // instructions spent repeating Fx0A while waiting for a key
+        unsigned long long faults = 0u;        // faults reported by step() or a run
+    };
+
+    unsigned long long frames = 0u;
+    unsigned long long draws = 0u;
+    unsigned long long pixelsToggled = 0u;
+    unsigned long long collisions = 0u;
+    unsigned long long keyWaitCycles = 0u;
+    unsigned long long faults = 0u;
+
+    // The Timer Ticks Before Each Timer Was Last Set, And What They Were Set To
+    unsigned long long timerTicks = 0u;
+    unsigned char delaySetTo = 0u;
+    unsigned char soundSetTo = 0u;
+    // Chip8::cycle When The Counters Were Last Reset
+    unsigned long long cycleAtReset = 0u;
+
+    // Note A Timer Being Set To "value" With "remaining" Ticks Left On It
+    void setDelay(unsigned char remaining, unsigned char value)
+    {
+        timerTicks += (delaySetTo > remaining) ? delaySetTo - remaining : 0u;
+        delaySetTo = value;
+    }
+    void setSound(unsigned char remaining, unsigned char value)
+    {
+        timerTicks += (soundSetTo > remaining) ? soundSetTo - remaining : 0u;
+        soundSetTo = value;
+    }
+
+    // Add Up The Counts For An Emulator At "cycle" With These Timers
+    Totals totals(unsigned long long cycle, unsigned char delayTimer, unsigned char soundTimer) const
+    {
+        Totals result;
+        result.instructions = (cycle > cycleAtReset) ? cycle - cycleAtReset : 0u;
+        result.frames = frames;
+        result.draws = draws;
+        result.pixelsToggled = pixelsToggled;
+        result.collisions = collisions;
+        result.timerTicks = timerTicks + ((delaySetTo > delayTimer) ? delaySetTo - delayTimer : 0u) + ((soundSetTo > soundTimer) ? soundSetTo - soundTimer : 0u);
+        result.keyWaitCycles = keyWaitCycles;
+        result.faults = faults;
+        return result;
+    }
+
+    // Start Counting Again From Zero For An Emulator At "cycle" With These Timers
+    void reset(unsigned long long cycle, unsigned char delayTimer, unsigned char soundTimer)
+    {
+        *this = PerformanceCounters();
+        cycleAtReset = cycle;
+        delaySetTo = delayTimer;
+        soundSetTo = soundTimer;
+    }
+};
+
+#endif // PERFORMANCECOUNTERS_H
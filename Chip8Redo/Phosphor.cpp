@@ -0,0 +1,85 @@
+#include <algorithm> //For Clamping The Decay
+#include "Phosphor.h"
+
+//Constructor
+Phosphor::Phosphor()
+{
+    reset();
+}
+
+void Phosphor::setDecay(int decay)
+{
+    decayPerFrame = std::min(std::max(decay, 1), MAX_BRIGHTNESS);
+    framesToSettle = (MAX_BRIGHTNESS + decayPerFrame - 1) / decayPerFrame;
+    reset();
+}
+
+// Clearing The Size Makes The Next Blend Start The Glow Again From That Frame
+void Phosphor::reset()
+{
+    width = 0;
+    height = 0;
+}
+
+// Fade One Row Of Glow, Then Light It Up Where The New Frame Is Lit (Levels 0 - 4 Become Brightnesses 0 - 255)
+void Phosphor::blendRow(unsigned char *glowRow, const unsigned char *levels, int rowWidth) const
+{
+    unsigned int fade = static_cast<unsigned int>(decayPerFrame);
+    for (int x = 0; x < rowWidth; x++)
+    {
+        unsigned int current = glowRow[x];
+        unsigned int faded = (current > fade) ? current - fade : 0u;
+        unsigned int lit = levels[x] * 64u;
+        lit -= lit >> 8u; // a fully lit level (256) becomes 255
+        glowRow[x] = static_cast<unsigned char>((faded > lit) ? faded : lit);
+    }
+}
+
+const unsigned char *Phosphor::blend(const Upscaler &upscaler, const unsigned long long rows[32])
+{
+    const unsigned char *levels = upscaler.output();
+    int factor = upscaler.factor();
+
+    // A New Size (Or A Reset) Starts The Glow From This Frame, This Is The Only Place The Buffer Grows
+    if (upscaler.width() != width || upscaler.height() != height)
+    {
+        width = upscaler.width();
+        height = upscaler.height();
+        glow.assign(levels, levels + static_cast<size_t>(width) * height);
+        for (unsigned char &brightness : glow)
+        {
+            brightness = static_cast<unsigned char>(std::min(brightness * 64, MAX_BRIGHTNESS));
+        }
+        std::copy(rows, rows + 32, previous);
+        std::fill(settling, settling + 32, 0);
+        return glow.data();
+    }
+
+    // A Display Row Has To Be Blended Again Once It Or A Row Next To It Changes, Until Its Glow Has Settled
+    for (int y = 0; y < 32; y++)
+    {
+        if (rows[y] != previous[y])
+        {
+            for (int near = std::max(y - 1, 0); near <= std::min(y + 1, 31); near++)
+            {
+                settling[near] = framesToSettle;
+            }
+        }
+    }
+    std::copy(rows, rows + 32, previous);
+
+    for (int y = 0; y < 32; y++)
+    {
+        if (settling[y] == 0)
+        {
+            continue;
+        }
+        --settling[y];
+        for (int row = y * factor; row < (y + 1) * factor; row++)
+        {
+            size_t offset = static_cast<size_t>(row) * width;
+            blendRow(glow.data() + offset, levels + offset, width);
+        }
+    }
+    return glow.data();
+}
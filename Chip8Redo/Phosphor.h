@@ -0,0 +1,45 @@
+#ifndef PHOSPHOR_H
+#define PHOSPHOR_H
+//ensure header is only declared once
+#include <vector> //For The Glow Buffer
+#include "Upscaler.h"
+
+/*
+Phosphor Persistence To Hide Sprite Flicker
+Chip8 programs move sprites by drawing them off and on again with Dxyn, so a sprite can be missing from every other frame.
+A CRT phosphor kept glowing for a while after the beam left, which hid this, and this stage does the same: every output
+pixel keeps a brightness (0 - 255) that jumps up when the pixel is lit and fades by "decay" each frame after it goes out.
+The fade and the blend are saturating byte operations in a plain loop (subtract clamped at 0, then the larger of the glow
+and the new pixel) which the compiler turns into SIMD code. A row only needs blending while it is still changing, so rows
+whose display pixels (and the rows next to them, which the filters look at) have not changed since the glow settled are skipped.
+*/
+class Phosphor
+{
+public:
+    static constexpr int MAX_BRIGHTNESS = 255;
+
+    // Constructor
+    Phosphor();
+
+    // How Much Brightness A Pixel Loses Each Frame Once It Goes Out, MAX_BRIGHTNESS Turns Persistence Off
+    void setDecay(int decayPerFrame);
+    int decay() const { return decayPerFrame; }
+    // Forget The Glow, So The Next Frame Is Shown As It Is
+    void reset();
+
+    // Blend The Display The Upscaler Just Scaled (From These Packed Rows) Into The Glow, Returns upscaler.width() * upscaler.height() Brightnesses
+    const unsigned char *blend(const Upscaler &upscaler, const unsigned long long rows[32]);
+
+private:
+    void blendRow(unsigned char *glowRow, const unsigned char *levels, int width) const;
+
+    int decayPerFrame = MAX_BRIGHTNESS;
+    int framesToSettle = 1; // frames a changed row needs before its glow matches its pixels again
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> glow;
+    unsigned long long previous[32]{}; // the packed rows blended last frame
+    int settling[32]{};                // frames each display row still has to be blended for
+};
+
+#endif // PHOSPHOR_H
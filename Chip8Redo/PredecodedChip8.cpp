@@ -0,0 +1,532 @@
+#include <algorithm> //For Clearing The Cache
+#include <cstring>   //For Comparing Memory With The Decoded Copy
+#include "PredecodedChip8.h"
+
+namespace
+{
+// Draw A Sprite Exactly As Chip8::OP_Dxyn Does (Without Watchpoints, Which Are Handed To step())
+void drawSprite(Chip8 &emulator, unsigned short opcode, unsigned short spriteAddress)
+{
+    emulator.drawSprite((opcode & 0x0F00u) >> 8u, (opcode & 0x00F0u) >> 4u, opcode & 0x000Fu, spriteAddress);
+}
+}
+
+//Constructor
+PredecodedChip8::PredecodedChip8()
+    : decoded(0x1000), decodedFrom(0x1000, 0u)
+{
+}
+
+// Forget Every Decoded Instruction
+void PredecodedChip8::invalidate()
+{
+    std::fill(decoded.begin(), decoded.end(), Decoded());
+}
+
+// The Operation One Opcode Decodes To, Following The Same Table Lookups As Chip8 (Including Which Digits They Ignore)
+PredecodedChip8::Operation PredecodedChip8::operationOf(unsigned short opcode)
+{
+    switch (opcode >> 12u)
+    {
+    case 0x0:
+        if ((opcode & 0x0FFFu) == 0x0E0u)
+        {
+            return ClearScreen;
+        }
+        return ((opcode & 0x0FFFu) == 0x0EEu) ? Return : Delegate; // 0nnn faults
+    case 0x1:
+        return Jump;
+    case 0x2:
+        return Call;
+    case 0x3:
+        return SkipIfEqual;
+    case 0x4:
+        return SkipIfNotEqual;
+    case 0x5:
+        return SkipIfRegistersEqual;
+    case 0x6:
+        return LoadImmediate;
+    case 0x7:
+        return AddImmediate;
+    case 0x8:
+    {
+        static const Operation table8[16] = {Move, Or, And, Xor, AddRegisters, Subtract, ShiftRight, SubtractReversed,
+                                             Delegate, Delegate, Delegate, Delegate, Delegate, Delegate, ShiftLeft, Delegate};
+        return table8[opcode & 0x000Fu];
+    }
+    case 0x9:
+        return SkipIfRegistersNotEqual;
+    case 0xA:
+        return LoadIndex;
+    case 0xB:
+        return JumpOffset;
+    case 0xC:
+        return Delegate; // the random number generator belongs to the emulator
+    case 0xD:
+        return Draw;
+    case 0xE:
+        if ((opcode & 0x000Fu) == 0x1u)
+        {
+            return SkipIfNotKey;
+        }
+        return ((opcode & 0x000Fu) == 0xEu) ? SkipIfKey : Delegate;
+    default:
+        switch (opcode & 0x00FFu)
+        {
+        case 0x07:
+            return ReadDelay;
+        case 0x0A:
+            return WaitKey;
+        case 0x15:
+            return SetDelay;
+        case 0x18:
+            return SetSound;
+        case 0x1E:
+            return AddIndex;
+        case 0x29:
+            return FontCharacter;
+        case 0x33:
+            return StoreDecimal;
+        case 0x55:
+            return StoreRegisters;
+        case 0x65:
+            return LoadRegisters;
+        default:
+            return Delegate; // faults
+        }
+    }
+}
+
+// Decode The Instruction At An Address, Fusing It With The Ones After It When They Form A Known Sequence
+void PredecodedChip8::decode(const Chip8 &emulator, unsigned short address)
+{
+    auto opcodeAt = [&emulator](unsigned int at)
+    {
+        return static_cast<unsigned short>((emulator.memory[at & 0x0FFFu] << 8u) | emulator.memory[(at + 1) & 0x0FFFu]);
+    };
+
+    Decoded &entry = decoded[address & 0x0FFFu];
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        entry.opcodes[i] = opcodeAt(address + 2 * i);
+    }
+    entry.operation = operationOf(entry.opcodes[0]);
+    entry.fusion = NotFused;
+
+    // Only Instructions step() Would Reach Before pcStop Can Be Part Of A Sequence
+    bool pair = address + 2u < decodedStop;
+    bool triple = address + 4u < decodedStop;
+    unsigned int first = entry.opcodes[0] >> 12u;
+    unsigned int second = entry.opcodes[1] >> 12u;
+    unsigned int third = entry.opcodes[2] >> 12u;
+
+    if (pair && first == 0xA && second == 0xD)
+    {
+        entry.fusion = IndexDraw;
+    }
+    else if (pair && first == 0x6 && second == 0x6)
+    {
+        entry.fusion = LoadPair;
+    }
+    else if (pair && first == 0xA && (entry.opcodes[1] & 0xF0FFu) == 0xF065u)
+    {
+        entry.fusion = IndexLoadRegisters;
+    }
+    else if (triple && (entry.opcodes[0] & 0xF0FFu) == 0xF007u && entry.opcodes[1] == (0x3000u | (entry.opcodes[0] & 0x0F00u)) && entry.opcodes[2] == (0x1000u | address))
+    {
+        entry.fusion = DelayWait;
+    }
+    else if (triple && first == 0x7 && second == 0x3 && third == 0x1)
+    {
+        entry.fusion = CountingLoop;
+    }
+}
+
+// Forget Every Decoding That Covers A Byte That Has Been Written, And Remember Its New Value
+void PredecodedChip8::written(const Chip8 &emulator, unsigned int address)
+{
+    address &= 0x0FFFu;
+    for (unsigned int back = 0; back < MAX_FUSED_BYTES; back++)
+    {
+        decoded[(address - back) & 0x0FFFu].operation = Undecoded;
+    }
+    decodedFrom[address] = emulator.memory[address];
+}
+
+// Bring The Cache Up To Date With Anything That Changed Outside The Engine (A New Program, Edited Memory, Another Emulator)
+void PredecodedChip8::synchronise(const Chip8 &emulator)
+{
+    if (emulator.pcStop != decodedStop)
+    {
+        invalidate();
+        decodedStop = emulator.pcStop;
+    }
+    if (std::memcmp(decodedFrom.data(), emulator.memory, 0x1000) != 0)
+    {
+        for (unsigned int address = 0; address < 0x1000; address++)
+        {
+            if (decodedFrom[address] != emulator.memory[address])
+            {
+                written(emulator, address);
+            }
+        }
+    }
+}
+
+// Execute Up To "cycleBudget" Instructions, Keeping The Machine State In Locals Like Chip8::run()
+Chip8::RunResult PredecodedChip8::run(Chip8 &emulator, unsigned long long cycleBudget)
+{
+    synchronise(emulator);
+
+    unsigned short programCounter = emulator.pc;
+    unsigned short indexRegister = emulator.index;
+    unsigned char stackPointer = emulator.sp;
+    unsigned char delay = emulator.delayTimer;
+    unsigned char sound = emulator.soundTimer;
+    unsigned short lastOpcode = emulator.opcode;
+    const unsigned short stop = emulator.pcStop;
+    const unsigned long long startCycle = emulator.cycle;
+    const bool watched = emulator.watchpoints != nullptr;
+    unsigned char *registers = emulator.registers;
+    unsigned char *memory = emulator.memory;
+    unsigned long long executed = 0;
+    Chip8::Fault fault = Chip8::NoFault;
+
+    auto writeBack = [&]()
+    {
+        emulator.pc = programCounter;
+        emulator.index = indexRegister;
+        emulator.sp = stackPointer;
+        emulator.delayTimer = delay;
+        emulator.soundTimer = sound;
+        emulator.opcode = lastOpcode;
+        emulator.cycle = startCycle + executed;
+    };
+    auto reload = [&]()
+    {
+        programCounter = emulator.pc;
+        indexRegister = emulator.index;
+        stackPointer = emulator.sp;
+        delay = emulator.delayTimer;
+        sound = emulator.soundTimer;
+        lastOpcode = emulator.opcode;
+    };
+    // Count Down The Timers And Count The Instruction, As step() Does After Every Instruction
+    auto retire = [&](unsigned short opcode)
+    {
+        lastOpcode = opcode;
+        if (delay > 0)
+        {
+            --delay;
+        }
+        if (sound > 0)
+        {
+            if (emulator.soundEnabled)
+            {
+                Beep(300, 10);
+            }
+            --sound;
+        }
+        ++executed;
+    };
+
+    while (executed < cycleBudget)
+    {
+        if (programCounter >= stop)
+        {
+            fault = Chip8::OutOfInstructions;
+            break;
+        }
+        const Decoded &entry = decoded[programCounter & 0x0FFFu];
+        if (entry.operation == Undecoded)
+        {
+            decode(emulator, programCounter);
+        }
+
+        // Fused Sequences Run Whole, So They Need Room In The Budget For Their Longest Path (Watched Memory Goes Through step())
+        if (entry.fusion != NotFused && cycleBudget - executed >= 3 && !watched)
+        {
+            const unsigned short *opcodes = entry.opcodes;
+            unsigned short start = programCounter;
+            unsigned long long before = executed;
+            switch (entry.fusion)
+            {
+            case IndexDraw:
+                indexRegister = opcodes[0] & 0x0FFFu;
+                retire(opcodes[0]);
+                drawSprite(emulator, opcodes[1], indexRegister);
+                retire(opcodes[1]);
+                programCounter += 4;
+                break;
+            case LoadPair:
+                registers[(opcodes[0] & 0x0F00u) >> 8u] = opcodes[0] & 0x00FFu;
+                retire(opcodes[0]);
+                registers[(opcodes[1] & 0x0F00u) >> 8u] = opcodes[1] & 0x00FFu;
+                retire(opcodes[1]);
+                programCounter += 4;
+                break;
+            case IndexLoadRegisters:
+                indexRegister = opcodes[0] & 0x0FFFu;
+                retire(opcodes[0]);
+                for (unsigned int i = 0; i <= ((opcodes[1] & 0x0F00u) >> 8u); i++)
+                {
+                    registers[i] = memory[indexRegister++ & 0x0FFFu];
+                }
+                retire(opcodes[1]);
+                programCounter += 4;
+                break;
+            case DelayWait:
+            {
+                // Go Round The Loop Until The Timer Reads Zero, The Skip Then Steps Over The Jump
+                unsigned int vxIndex = (opcodes[0] & 0x0F00u) >> 8u;
+                do
+                {
+                    registers[vxIndex] = delay;
+                    retire(opcodes[0]);
+                    if (registers[vxIndex] == 0u)
+                    {
+                        retire(opcodes[1]);
+                        programCounter = start + 6;
+                        break;
+                    }
+                    retire(opcodes[1]);
+                    retire(opcodes[2]);
+                } while (cycleBudget - executed >= 3);
+                break;
+            }
+            case CountingLoop:
+            {
+                // Add, Then Either Skip The Jump Once The Register Reaches The Value Or Jump (Going Round Again While It Jumps To Itself)
+                unsigned int addIndex = (opcodes[0] & 0x0F00u) >> 8u;
+                unsigned int testIndex = (opcodes[1] & 0x0F00u) >> 8u;
+                unsigned char step = opcodes[0] & 0x00FFu;
+                unsigned char target = opcodes[1] & 0x00FFu;
+                do
+                {
+                    registers[addIndex] += step;
+                    retire(opcodes[0]);
+                    retire(opcodes[1]);
+                    if (registers[testIndex] == target)
+                    {
+                        programCounter = start + 6;
+                        break;
+                    }
+                    retire(opcodes[2]);
+                    programCounter = opcodes[2] & 0x0FFFu;
+                } while (programCounter == start && cycleBudget - executed >= 3);
+                break;
+            }
+            default:
+                break;
+            }
+            fused += executed - before;
+            continue;
+        }
+
+        unsigned short opcode = entry.opcodes[0];
+        unsigned int x = (opcode & 0x0F00u) >> 8u;
+        unsigned int y = (opcode & 0x00F0u) >> 4u;
+        unsigned char nn = opcode & 0x00FFu;
+        unsigned short nnn = opcode & 0x0FFFu;
+        Operation operation = entry.operation;
+
+        // Anything Needing The Emulator (Or About To Fault, Or Touching Watched Memory) Is Executed By step() Itself
+        bool memoryOperation = operation == Draw || operation == StoreDecimal || operation == StoreRegisters || operation == LoadRegisters;
+        if (operation == Delegate || (watched && memoryOperation) || (operation == Return && stackPointer == 0u) || (operation == Call && stackPointer >= 16u))
+        {
+            unsigned short writeFrom = indexRegister;
+            writeBack();
+            fault = emulator.step();
+            reload();
+            if (fault != Chip8::NoFault)
+            {
+                break;
+            }
+            ++executed;
+            if (operation == StoreDecimal || operation == StoreRegisters)
+            {
+                for (unsigned int i = 0; i <= ((operation == StoreDecimal) ? 2u : x); i++)
+                {
+                    written(emulator, writeFrom + i);
+                }
+            }
+            continue;
+        }
+
+        programCounter += 2;
+        int result;
+        switch (operation)
+        {
+        case ClearScreen:
+            setAllValues(emulator.video, 0u);
+            break;
+        case Return:
+            programCounter = emulator.stack[--stackPointer];
+            break;
+        case Jump:
+            programCounter = nnn;
+            break;
+        case Call:
+            emulator.stack[stackPointer++] = programCounter;
+            programCounter = nnn;
+            break;
+        case SkipIfEqual:
+            programCounter += (registers[x] == nn) ? 2 : 0;
+            break;
+        case SkipIfNotEqual:
+            programCounter += (registers[x] != nn) ? 2 : 0;
+            break;
+        case SkipIfRegistersEqual:
+            programCounter += (registers[x] == registers[y]) ? 2 : 0;
+            break;
+        case SkipIfRegistersNotEqual:
+            programCounter += (registers[x] != registers[y]) ? 2 : 0;
+            break;
+        case LoadImmediate:
+            registers[x] = nn;
+            break;
+        case AddImmediate:
+            registers[x] += nn;
+            break;
+        // Each Statement Is In The Same Order As Its Operation Function, So VF Ends Up The Same When X Or Y Is F
+        case Move:
+            registers[x] = registers[y];
+            break;
+        case Or:
+            registers[x] |= registers[y];
+            break;
+        case And:
+            registers[x] &= registers[y];
+            break;
+        case Xor:
+            registers[x] ^= registers[y];
+            break;
+        case AddRegisters:
+            result = registers[x] + registers[y];
+            registers[x] += registers[y];
+            registers[0xF] = (result > 0xFF) ? 0x01u : 0x00u;
+            break;
+        case Subtract:
+            result = registers[x] - registers[y];
+            registers[x] -= registers[y];
+            registers[0xF] = (result < 0) ? 0x00u : 0x01u;
+            break;
+        case ShiftRight:
+            registers[0xF] = registers[y] & 1u;
+            registers[x] = registers[y] >> 1u;
+            break;
+        case SubtractReversed:
+            result = registers[y] - registers[x];
+            registers[x] = registers[y] - registers[x];
+            registers[0xF] = (result < 0) ? 0x00u : 0x01u;
+            break;
+        case ShiftLeft:
+            registers[0xF] = registers[y] >> 7u;
+            registers[x] = registers[y] << 1u;
+            break;
+        case LoadIndex:
+            indexRegister = nnn;
+            break;
+        case JumpOffset:
+            programCounter = static_cast<unsigned short>(nnn + registers[0]);
+            break;
+        case Draw:
+            drawSprite(emulator, opcode, indexRegister);
+            break;
+        case SkipIfKey:
+        case SkipIfNotKey:
+            if (emulator.inputLatency != nullptr)
+            {
+                emulator.inputLatency->observed();
+            }
+            if ((registers[x] <= 0xF && emulator.keypad.pressed(registers[x])) == (operation == SkipIfKey))
+            {
+                programCounter += 2;
+            }
+            break;
+        case ReadDelay:
+            registers[x] = delay;
+            break;
+        case WaitKey:
+        {
+            // As Chip8::OP_Fx0A, Finish On The Lowest Key Let Go Since The Wait Began, Otherwise Repeat This Instruction
+            if (emulator.inputLatency != nullptr)
+            {
+                emulator.inputLatency->observed();
+            }
+            unsigned short held = emulator.keypad.load();
+            unsigned short released = emulator.keyWaitMask & ~held;
+            if (released != 0u)
+            {
+                unsigned char key = 0u;
+                while (((released >> key) & 1u) == 0u)
+                {
+                    ++key;
+                }
+                registers[x] = key;
+                emulator.keyWaitMask = 0u;
+                emulator.waitingForKey = false;
+            }
+            else
+            {
+                emulator.keyWaitMask |= held;
+                emulator.waitingForKey = true;
+                ++emulator.counters.keyWaitCycles;
+                programCounter -= 2;
+            }
+            break;
+        }
+        case SetDelay:
+            emulator.counters.setDelay(delay, registers[x]);
+            delay = registers[x];
+            break;
+        case SetSound:
+            emulator.counters.setSound(sound, registers[x]);
+            sound = registers[x];
+            break;
+        case AddIndex:
+            indexRegister += registers[x];
+            break;
+        case FontCharacter:
+            indexRegister = static_cast<unsigned short>(0x50u + registers[x] * 5); // Chip8's FONTSET_START_ADDRESS
+            break;
+        case StoreDecimal:
+            emulator.markWritten(indexRegister, 3);
+            memory[indexRegister & 0x0FFFu] = registers[x] / 100;
+            memory[(indexRegister + 1) & 0x0FFFu] = (registers[x] % 100) / 10;
+            memory[(indexRegister + 2) & 0x0FFFu] = registers[x] % 10;
+            for (unsigned int i = 0; i < 3; i++)
+            {
+                written(emulator, indexRegister + i);
+            }
+            break;
+        case StoreRegisters:
+            emulator.markWritten(indexRegister, x + 1u);
+            for (unsigned int i = 0; i <= x; i++)
+            {
+                memory[indexRegister & 0x0FFFu] = registers[i];
+                written(emulator, indexRegister++);
+            }
+            break;
+        case LoadRegisters:
+            for (unsigned int i = 0; i <= x; i++)
+            {
+                registers[i] = memory[indexRegister++ & 0x0FFFu];
+            }
+            break;
+        default:
+            break;
+        }
+        retire(opcode);
+    }
+
+    total += executed;
+    writeBack();
+    if (fault != Chip8::NoFault)
+    {
+        return emulator.faulted(fault, executed);
+    }
+    Chip8::RunResult result;
+    result.executed = executed;
+    return result;
+}
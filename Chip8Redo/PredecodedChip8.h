@@ -0,0 +1,113 @@
+#ifndef PREDECODEDCHIP8_H
+#define PREDECODEDCHIP8_H
+//ensure header is only declared once
+#include <vector> //For The Decoded Instruction Cache
+#include "Chip8.h"
+
+/*
+Runs A Chip8 From A Cache Of Predecoded Instructions, With Common Sequences Fused Into One Operation
+The first time an address is executed its opcode is decoded once into a flat operation number, so running it again is a
+single switch instead of the MASTER_TABLE and its sub tables. While decoding, a peephole pass looks at the instructions that
+follow and fuses the sequences that dominate real programs into superinstructions:
+    Annn, Dxyn         set the index and draw
+    6xnn, 6ynn         load two registers
+    Annn, Fx65         set the index and load registers from it
+    Fx07, 3x00, 1nnn   wait for the delay timer (the jump goes back to the Fx07), run until it expires or the budget ends
+    7xnn, 3xnn, 1nnn   count a register up to a value, jumping back until it gets there
+A fused operation still counts, times and budgets every instruction in it exactly as step() would.
+Decodings are kept per address, so a jump or skip into the middle of a fused sequence finds the decoding of the instruction
+it lands on rather than the sequence. Writing memory (Fx33 and Fx55, or anything outside the engine between runs, which is
+found by comparing memory with the copy the cache was decoded from) forgets every decoding that covers the bytes written.
+Instructions that need the emulator itself (random numbers, faults, memory while watchpoints are set) are handed to Chip8::step().
+*/
+class PredecodedChip8
+{
+public:
+    // Constructor
+    PredecodedChip8();
+
+    // Execute Up To "cycleBudget" Instructions On The Emulator, Stopping Early Only On A Fault (The Same Instructions step() Would Run)
+    Chip8::RunResult run(Chip8 &emulator, unsigned long long cycleBudget);
+    // Forget Every Decoded Instruction
+    void invalidate();
+
+    // How Many Instructions Have Run Inside Fused Operations, And In Total, Since The Engine Was Made
+    unsigned long long fusedInstructions() const { return fused; }
+    unsigned long long totalInstructions() const { return total; }
+
+private:
+    // The Operation A Single Instruction Decodes To
+    enum Operation : unsigned char
+    {
+        Undecoded = 0,
+        Delegate, // handed to Chip8::step()
+        ClearScreen,
+        Return,
+        Jump,
+        Call,
+        SkipIfEqual,
+        SkipIfNotEqual,
+        SkipIfRegistersEqual,
+        SkipIfRegistersNotEqual,
+        LoadImmediate,
+        AddImmediate,
+        Move,
+        Or,
+        And,
+        Xor,
+        AddRegisters,
+        Subtract,
+        ShiftRight,
+        SubtractReversed,
+        ShiftLeft,
+        LoadIndex,
+        JumpOffset,
+        Draw,
+        SkipIfKey,
+        SkipIfNotKey,
+        ReadDelay,
+        WaitKey,
+        SetDelay,
+        SetSound,
+        AddIndex,
+        FontCharacter,
+        StoreDecimal,
+        StoreRegisters,
+        LoadRegisters
+    };
+
+    // The Sequence Starting At An Address, If It Was Fused
+    enum Fusion : unsigned char
+    {
+        NotFused = 0,
+        IndexDraw,          // Annn, Dxyn
+        LoadPair,           // 6xnn, 6ynn
+        IndexLoadRegisters, // Annn, Fx65
+        DelayWait,          // Fx07, 3x00, 1nnn back to the Fx07
+        CountingLoop        // 7xnn, 3xnn, 1nnn
+    };
+
+    // The Decoding Of The Instruction At One Address (And The Two After It When Fused)
+    struct Decoded
+    {
+        Operation operation = Undecoded;
+        Fusion fusion = NotFused;
+        unsigned short opcodes[3] = {};
+    };
+
+    // The Longest Fused Sequence In Bytes, A Write Can Change The Decoding Of Any Address This Far Before It
+    static constexpr unsigned int MAX_FUSED_BYTES = 6;
+
+    static Operation operationOf(unsigned short opcode);
+    void decode(const Chip8 &emulator, unsigned short address);
+    void written(const Chip8 &emulator, unsigned int address);
+    void synchronise(const Chip8 &emulator);
+
+    std::vector<Decoded> decoded;           // one entry per address
+    std::vector<unsigned char> decodedFrom; // the memory the cache was decoded from
+    unsigned short decodedStop = 0;         // the pcStop the cache was decoded with
+    unsigned long long fused = 0;
+    unsigned long long total = 0;
+};
+
+#endif // PREDECODEDCHIP8_H
@@ -0,0 +1,142 @@
+#ifndef RECOMPILEDRUNTIME_H
+#define RECOMPILEDRUNTIME_H
+//ensure header is only declared once
+#include <cstddef> //For Sizes
+#include <cstring> //For Checking The Code Is Unchanged
+#include "Chip8.h"
+
+/*
+The Support Code A Recompiled Program Links Against (See Recompiler.h)
+A recompiled program is one C++ function per straight run of instructions (a segment), working directly on a Chip8: its
+registers, display, timers and keypad are the same ones the interpreter uses, so the window, captures and every headless
+tool can run it in place of Chip8::step(). run() below is the dispatcher: it looks up the segment starting at the program
+counter and runs it, and anything it has no segment for (Bnnn targets, addresses reached only at run time, instructions
+that were left to the interpreter, code that has been overwritten) is executed one instruction at a time by Chip8::step().
+*/
+namespace RecompiledRuntime
+{
+// A Range Of Addresses That Hold Recompiled Instructions
+struct CodeRange
+{
+    unsigned short start;
+    unsigned short end; // one past the last byte
+};
+
+/* Run The Segment Starting At emulator.pc If There Is One And It Fits In The Budget, Adding The Instructions It Ran To "executed"
+(Leaving It Unchanged Means There Was Nothing To Run), And Setting "wroteMemory" If It Stored Anything*/
+typedef void (*SegmentDispatch)(Chip8 &emulator, unsigned long long &executed, unsigned long long cycleBudget, bool &wroteMemory);
+
+// Everything The Recompiler Emits For One ROM
+struct Program
+{
+    const unsigned char *rom;  // the ROM file, loaded at 0x200
+    size_t romSize;
+    unsigned short programEnd; // the pcStop loading it gives
+    const CodeRange *code;
+    size_t codeRanges;
+    SegmentDispatch dispatch;
+};
+
+// Count Down The Timers And Count The Instruction, As step() Does After Every Instruction
+inline void retire(Chip8 &emulator, unsigned long long &executed)
+{
+    if (emulator.delayTimer > 0)
+    {
+        --emulator.delayTimer;
+    }
+    if (emulator.soundTimer > 0)
+    {
+        if (emulator.soundEnabled)
+        {
+            Beep(300, 10);
+        }
+        --emulator.soundTimer;
+    }
+    ++emulator.cycle;
+    ++executed;
+}
+
+// Draw A Sprite Exactly As Chip8::OP_Dxyn Does (Watchpoints Never Reach Recompiled Code)
+inline void draw(Chip8 &emulator, unsigned int vxIndex, unsigned int vyIndex, unsigned int height)
+{
+    emulator.drawSprite(vxIndex, vyIndex, height, emulator.index);
+}
+
+// Report A Key Skip's Read Of The Keypad, Returning True If The Key Named By VX Is Pressed
+inline bool keyPressed(Chip8 &emulator, unsigned int vxIndex)
+{
+    if (emulator.inputLatency != nullptr)
+    {
+        emulator.inputLatency->observed();
+    }
+    unsigned char key = emulator.registers[vxIndex];
+    return key <= 0xF && emulator.keypad.pressed(key);
+}
+
+// True If The Emulator Still Holds The Program That Was Recompiled, With Its Instructions Unchanged
+inline bool codeIntact(const Program &program, const Chip8 &emulator)
+{
+    for (size_t i = 0; i < program.codeRanges; i++)
+    {
+        const CodeRange &range = program.code[i];
+        if (std::memcmp(emulator.memory + range.start, program.rom + (range.start - 0x200), range.end - range.start) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// True If The Recompiled Code Can Run: Nothing Is Watched (Watched Memory Is Reported By The Interpreter's Own Instructions) And The Code Is Unchanged
+inline bool canDispatch(const Program &program, const Chip8 &emulator)
+{
+    return emulator.watchpoints == nullptr && emulator.pcStop == program.programEnd && codeIntact(program, emulator);
+}
+
+/* Execute Up To "cycleBudget" Instructions, Stopping Early Only On A Fault (The Same Instructions step() Would Run)
+Every segment ends at a store, so the code is checked again after any store before another segment runs, whether the store
+was made by a segment or by step()*/
+inline Chip8::RunResult run(const Program &program, Chip8 &emulator, unsigned long long cycleBudget)
+{
+    bool intact = canDispatch(program, emulator);
+    unsigned long long executed = 0;
+    while (executed < cycleBudget)
+    {
+        if (emulator.pc >= emulator.pcStop)
+        {
+            return emulator.faulted(Chip8::OutOfInstructions, executed);
+        }
+        unsigned long long before = executed;
+        if (intact)
+        {
+            bool wroteMemory = false;
+            program.dispatch(emulator, executed, cycleBudget, wroteMemory);
+            if (wroteMemory)
+            {
+                intact = canDispatch(program, emulator);
+            }
+        }
+        if (executed == before)
+        {
+            Chip8::Fault fault = emulator.step();
+            if (fault != Chip8::NoFault)
+            {
+                return emulator.faulted(fault, executed);
+            }
+            ++executed;
+            if ((emulator.opcode & 0xF0FFu) == 0xF033u || (emulator.opcode & 0xF0FFu) == 0xF055u)
+            {
+                intact = canDispatch(program, emulator);
+            }
+        }
+    }
+    Chip8::RunResult result;
+    result.executed = executed;
+    return result;
+}
+}
+
+// The Entry Point Every Recompiled Program Defines
+Chip8::RunResult runRecompiledProgram(Chip8 &emulator, unsigned long long cycleBudget);
+
+#endif // RECOMPILEDRUNTIME_H
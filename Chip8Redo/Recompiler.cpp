@@ -0,0 +1,318 @@
+#include <algorithm> //For Merging Code Ranges
+#include <cstdio>    //For Formatting The Generated Code
+#include <sstream>   //For Building The Output
+#include "Recompiler.h"
+
+namespace
+{
+Chip8 loadedEmulator(const std::vector<unsigned char> &rom)
+{
+    Chip8 emulator;
+    emulator.loadProgram(rom.data(), rom.size());
+    return emulator;
+}
+
+std::string format(const char *pattern, unsigned int a = 0, unsigned int b = 0, unsigned int c = 0, unsigned int d = 0)
+{
+    char text[512];
+    std::snprintf(text, sizeof(text), pattern, a, b, c, d);
+    return text;
+}
+}
+
+//Constructor
+Recompiler::Recompiler(const std::vector<unsigned char> &rom)
+    : romBytes(rom), emulator(loadedEmulator(rom)), graph(emulator)
+{
+    formSegments();
+}
+
+size_t Recompiler::instructionCount() const
+{
+    size_t count = 0;
+    for (const Segment &segment : segments)
+    {
+        count += (segment.end - segment.start) / 2;
+    }
+    return count;
+}
+
+// Split Every Block After Its Calls And Stores And Around The Instructions Left To The Interpreter
+void Recompiler::formSegments()
+{
+    for (const auto &entry : graph.blocks())
+    {
+        const ControlFlowGraph::Block &block = entry.second;
+        unsigned short start = block.start;
+        for (unsigned short address = block.start; address < block.end; address += 2)
+        {
+            unsigned short opcode = (emulator.memory[address] << 8u) | emulator.memory[address + 1];
+            bool ends = false;
+            if (instruction(address, opcode, ends).empty())
+            {
+                if (address > start)
+                {
+                    segments.push_back({start, address});
+                }
+                interpreted.push_back(address);
+                start = address + 2;
+            }
+            else if ((opcode >> 12u) == 0x2u || (opcode & 0xF0FFu) == 0xF033u || (opcode & 0xF0FFu) == 0xF055u)
+            {
+                segments.push_back({start, static_cast<unsigned short>(address + 2)});
+                start = address + 2;
+            }
+        }
+        if (block.end > start)
+        {
+            segments.push_back({start, block.end});
+        }
+    }
+}
+
+// The C++ For One Instruction, Following The Operation Functions In Chip8.h Statement For Statement
+std::string Recompiler::instruction(unsigned short address, unsigned short opcode, bool &ends) const
+{
+    unsigned int x = (opcode & 0x0F00u) >> 8u;
+    unsigned int y = (opcode & 0x00F0u) >> 4u;
+    unsigned int n = opcode & 0x000Fu;
+    unsigned int nn = opcode & 0x00FFu;
+    unsigned int nnn = opcode & 0x0FFFu;
+    unsigned int next = address + 2u;
+    unsigned int skip = address + 4u;
+    const char *retire = "RecompiledRuntime::retire(emulator, executed);";
+    ends = false;
+
+    // Instructions That Leave The Segment Set The Opcode And Program Counter, Retire And Return
+    auto leave = [&](const std::string &setPc)
+    {
+        ends = true;
+        return format("emulator.opcode = 0x%04X;\n    ", opcode) + setPc + "\n    " + retire + "\n    return;";
+    };
+    // An Instruction That Would Fault Stops The Segment Before It, So step() Reports The Fault
+    auto stopBefore = [&](const std::string &condition)
+    {
+        return "if (" + condition + ")\n    {\n        emulator.pc = " + format("0x%03X", address) + ";\n        return;\n    }\n    ";
+    };
+
+    switch (opcode >> 12u)
+    {
+    case 0x0:
+        if (opcode == 0x00E0u)
+        {
+            return "setAllValues(emulator.video, 0u);";
+        }
+        if (opcode == 0x00EEu)
+        {
+            return stopBefore("emulator.sp == 0u") + leave("emulator.pc = emulator.stack[--emulator.sp];");
+        }
+        return ""; // 0nnn faults
+    case 0x1:
+        return leave(format("emulator.pc = 0x%03X;", nnn));
+    case 0x2:
+        return stopBefore("emulator.sp >= 16u") + leave(format("emulator.stack[emulator.sp++] = 0x%03X;\n    emulator.pc = 0x%03X;", next, nnn));
+    case 0x3:
+        return leave(format("emulator.pc = (V[%u] == 0x%02X) ? 0x%03X : 0x%03X;", x, nn, skip, next));
+    case 0x4:
+        return leave(format("emulator.pc = (V[%u] != 0x%02X) ? 0x%03X : 0x%03X;", x, nn, skip, next));
+    case 0x5:
+        return (n != 0u) ? "" : leave(format("emulator.pc = (V[%u] == V[%u]) ? 0x%03X : 0x%03X;", x, y, skip, next));
+    case 0x6:
+        return format("V[%u] = 0x%02X;", x, nn);
+    case 0x7:
+        return format("V[%u] += 0x%02X;", x, nn);
+    case 0x8:
+        switch (n)
+        {
+        case 0x0:
+            return format("V[%u] = V[%u];", x, y);
+        case 0x1:
+            return format("V[%u] |= V[%u];", x, y);
+        case 0x2:
+            return format("V[%u] &= V[%u];", x, y);
+        case 0x3:
+            return format("V[%u] ^= V[%u];", x, y);
+        case 0x4:
+            return format("result = V[%u] + V[%u];\n    V[%u] += V[%u];\n    V[15] = (result > 0xFF) ? 1u : 0u;", x, y, x, y);
+        case 0x5:
+            return format("result = V[%u] - V[%u];\n    V[%u] -= V[%u];\n    V[15] = (result < 0) ? 0u : 1u;", x, y, x, y);
+        case 0x6:
+            return format("V[15] = V[%u] & 1u;\n    V[%u] = V[%u] >> 1u;", y, x, y);
+        case 0x7:
+            return format("result = V[%u] - V[%u];\n    V[%u] = static_cast<unsigned char>(result);\n    V[15] = (result < 0) ? 0u : 1u;", y, x, x);
+        case 0xE:
+            return format("V[15] = V[%u] >> 7u;\n    V[%u] = V[%u] << 1u;", y, x, y);
+        default:
+            return "";
+        }
+    case 0x9:
+        return (n != 0u) ? "" : leave(format("emulator.pc = (V[%u] != V[%u]) ? 0x%03X : 0x%03X;", x, y, skip, next));
+    case 0xA:
+        return format("emulator.index = 0x%03X;", nnn);
+    case 0xB:
+        return leave(format("emulator.pc = static_cast<unsigned short>(0x%03X + V[0]);", nnn));
+    case 0xC:
+        return ""; // the random number generator belongs to the emulator
+    case 0xD:
+        return format("RecompiledRuntime::draw(emulator, %u, %u, %u);", x, y, n);
+    case 0xE:
+        // The E Table Only Looks At The Last Digit
+        if (n == 0xEu)
+        {
+            return leave(format("emulator.pc = RecompiledRuntime::keyPressed(emulator, %u) ? 0x%03X : 0x%03X;", x, skip, next));
+        }
+        if (n == 0x1u)
+        {
+            return leave(format("emulator.pc = RecompiledRuntime::keyPressed(emulator, %u) ? 0x%03X : 0x%03X;", x, next, skip));
+        }
+        return "";
+    default:
+        switch (nn)
+        {
+        case 0x07:
+            return format("V[%u] = emulator.delayTimer;", x);
+        case 0x15:
+            return format("emulator.counters.setDelay(emulator.delayTimer, V[%u]); emulator.delayTimer = V[%u];", x, x);
+        case 0x18:
+            return format("emulator.counters.setSound(emulator.soundTimer, V[%u]); emulator.soundTimer = V[%u];", x, x);
+        case 0x1E:
+            return format("emulator.index += V[%u];", x);
+        case 0x29:
+            return format("emulator.index = static_cast<unsigned short>(0x50 + V[%u] * 5);", x);
+        case 0x33:
+            return format("emulator.markWritten(emulator.index, 3);\n    emulator.memory[emulator.index & 0x0FFFu] = V[%u] / 100;\n    emulator.memory[(emulator.index + 1) & 0x0FFFu] = (V[%u] %% 100) / 10;\n"
+                          "    emulator.memory[(emulator.index + 2) & 0x0FFFu] = V[%u] %% 10;\n    wroteMemory = true;",
+                          x, x, x);
+        case 0x55:
+            return format("emulator.markWritten(emulator.index, %u);\n    for (unsigned int i = 0; i <= %u; i++)\n    {\n        emulator.memory[emulator.index++ & 0x0FFFu] = V[i];\n    }\n    wroteMemory = true;", x + 1u, x);
+        case 0x65:
+            return format("for (unsigned int i = 0; i <= %u; i++)\n    {\n        V[i] = emulator.memory[emulator.index++ & 0x0FFFu];\n    }", x);
+        default:
+            return ""; // Fx0A waits on the emulator's key state, anything else faults
+        }
+    }
+}
+
+// One Segment As A Function, Which Only Runs If The Whole Of It Fits In The Budget
+std::string Recompiler::segmentFunction(const Segment &segment) const
+{
+    std::ostringstream body;
+    bool ends = false;
+    unsigned short opcode = 0u;
+    for (unsigned short address = segment.start; address < segment.end; address += 2)
+    {
+        opcode = (emulator.memory[address] << 8u) | emulator.memory[address + 1];
+        body << format("    // 0x%03X  %04X  ", address, opcode) << disassemble(opcode) << "\n";
+        body << "    " << instruction(address, opcode, ends) << "\n";
+        if (!ends)
+        {
+            body << "    RecompiledRuntime::retire(emulator, executed);\n";
+        }
+    }
+    if (!ends)
+    {
+        body << format("    emulator.opcode = 0x%04X;\n    emulator.pc = 0x%03X;\n", opcode, segment.end);
+    }
+
+    std::string code = body.str();
+    std::ostringstream out;
+    out << format("// 0x%03X - 0x%03X\n", segment.start, segment.end - 2u);
+    out << format("void segment%03X(Chip8 &emulator, unsigned long long &executed, unsigned long long cycleBudget, bool &", segment.start)
+        << ((code.find("wroteMemory") != std::string::npos) ? "wroteMemory" : "/*wroteMemory*/") << ")\n{\n";
+    out << format("    if (cycleBudget - executed < %u)\n    {\n        return;\n    }\n", (segment.end - segment.start) / 2u);
+    if (code.find("V[") != std::string::npos)
+    {
+        out << "    unsigned char *V = emulator.registers;\n";
+    }
+    if (code.find("result = ") != std::string::npos)
+    {
+        out << "    int result;\n";
+    }
+    out << code << "}\n\n";
+    return out.str();
+}
+
+// The Whole Generated Source File
+std::string Recompiler::source(const std::string &romName, bool withMain) const
+{
+    std::ostringstream out;
+    out << "// " << romName << " Recompiled To C++ By Chip8Redo --recompile, Do Not Edit\n";
+    out << "// Build With Chip8.cpp, Watchpoints.cpp And InputLatency.cpp" << (withMain ? ", Then Run With The Number Of Instructions To Time" : "") << "\n";
+    if (withMain)
+    {
+        out << "#include <chrono>   //For Timing The Program\n#include <cstdlib>  //For Reading The Instruction Count\n#include <iostream> //For Printing The Result\n";
+    }
+    out << "#include \"RecompiledRuntime.h\"\n\nnamespace\n{\n";
+
+    // The ROM, So A Program Can Load Itself And The Dispatcher Can Check Its Code Is Still In Memory
+    out << "const unsigned char ROM[] = {";
+    for (size_t i = 0; i < romBytes.size(); i++)
+    {
+        out << ((i % 16 == 0) ? "\n    " : " ") << format("0x%02X,", romBytes[i]);
+    }
+    out << "\n    0x00}; // (a trailing byte so an empty ROM still compiles)\n\n";
+
+    // The Code Ranges, Merging Neighbouring Segments
+    std::vector<Segment> ranges;
+    for (const Segment &segment : segments)
+    {
+        if (!ranges.empty() && ranges.back().end >= segment.start)
+        {
+            ranges.back().end = std::max(ranges.back().end, segment.end);
+        }
+        else
+        {
+            ranges.push_back(segment);
+        }
+    }
+    out << "const RecompiledRuntime::CodeRange CODE[] = {";
+    for (const Segment &range : ranges)
+    {
+        out << format("\n    {0x%03X, 0x%03X},", range.start, range.end);
+    }
+    out << "\n    {0x200, 0x200}};\n\n";
+
+    for (const Segment &segment : segments)
+    {
+        out << segmentFunction(segment);
+    }
+
+    out << (segments.empty() ? "void dispatch(Chip8 &emulator, unsigned long long &, unsigned long long, bool &)\n{\n"
+                             : "void dispatch(Chip8 &emulator, unsigned long long &executed, unsigned long long cycleBudget, bool &wroteMemory)\n{\n");
+    out << "    switch (emulator.pc)\n    {\n";
+    for (const Segment &segment : segments)
+    {
+        out << format("    case 0x%03X:\n        segment%03X(emulator, executed, cycleBudget, wroteMemory);\n        break;\n", segment.start, segment.start);
+    }
+    out << "    default:\n        break;\n    }\n}\n}\n\n";
+
+    out << format("const RecompiledRuntime::Program PROGRAM = {ROM, %u, 0x%03X, CODE, sizeof(CODE) / sizeof(CODE[0]), dispatch};\n\n",
+                  static_cast<unsigned int>(romBytes.size()), emulator.pcStop);
+    out << "Chip8::RunResult runRecompiledProgram(Chip8 &emulator, unsigned long long cycleBudget)\n{\n";
+    out << "    return RecompiledRuntime::run(PROGRAM, emulator, cycleBudget);\n}\n";
+
+    if (withMain)
+    {
+        out << "\n// Run The Program For The Number Of Instructions Given (100 Million By Default), Print How Fast It Ran And Check It Against The Interpreter\n";
+        out << "int main(int argc, char *argv[])\n{\n";
+        out << "    unsigned long long cycles = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000000ull;\n";
+        out << "    Chip8 emulator;\n    emulator.seedRandom(1u);\n    emulator.soundEnabled = false;\n";
+        out << "    emulator.loadProgram(ROM, PROGRAM.romSize);\n\n";
+        out << "    auto start = std::chrono::steady_clock::now();\n";
+        out << "    Chip8::RunResult result = runRecompiledProgram(emulator, cycles);\n";
+        out << "    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;\n\n";
+        out << "    std::cout << result.executed << \" instructions in \" << seconds.count() << \"s (\" << result.executed / seconds.count() / 1e6\n";
+        out << "              << \" MIPS), state hash \" << std::hex << emulator.hashState() << std::dec << \"\\n\";\n";
+        out << "    if (!result.ok())\n    {\n";
+        out << "        std::cout << Chip8::faultMessage(result.fault, result.opcode) << \"\\n\";\n    }\n\n";
+        out << "    // Run The Same Instructions Through The Interpreter, Which The Recompiled Program Has To Match Exactly\n";
+        out << "    Chip8 interpreted;\n    interpreted.seedRandom(1u);\n    interpreted.soundEnabled = false;\n";
+        out << "    interpreted.loadProgram(ROM, PROGRAM.romSize);\n";
+        out << "    Chip8::RunResult expected = interpreted.runInstructions(cycles);\n";
+        out << "    bool matches = expected.executed == result.executed && expected.fault == result.fault && interpreted.hashState() == emulator.hashState() &&\n";
+        out << "                   interpreted.opcode == emulator.opcode;\n";
+        out << "    std::cout << (matches ? \"Matches the interpreter\\n\" : \"DIFFERS from the interpreter\\n\");\n";
+        out << "    return (result.ok() && matches) ? 0 : 1;\n}\n";
+    }
+    return out.str();
+}
@@ -0,0 +1,54 @@
+#ifndef RECOMPILER_H
+#define RECOMPILER_H
+//ensure header is only declared once
+#include <string> //For The Generated Source
+#include <vector> //For The ROM And Segments
+#include "ControlFlowGraph.h"
+
+/*
+Ahead Of Time Recompiler From A ROM To C++
+The control flow graph finds every basic block the program can reach, and each block becomes one or more C++ functions
+(segments) that carry out its instructions directly on a Chip8, with every opcode, address and register number written in
+as a constant, so nothing is fetched or decoded when it runs. A block is split after each call (so the return lands on the
+start of a segment), after each store (Fx33 and Fx55, so code the program overwrites is caught before any more of it runs)
+and around the instructions left to the interpreter (Cxnn, whose random numbers belong to the emulator, Fx0A, and anything
+the emulator would fault on). A switch on the program counter picks the segment to run, and whatever it
+has no segment for (Bnnn targets, overwritten code) is run by Chip8::step() (see RecompiledRuntime.h).
+The output is a single source file that compiles with Chip8.cpp, Watchpoints.cpp and InputLatency.cpp into an executable
+(with --main, which times the program and then checks it ended up exactly where the interpreter does) or into a library that calls runRecompiledProgram() in place of the interpreter.
+*/
+class Recompiler
+{
+public:
+    // Constructor (Analyses The ROM As loadProgram() Would Load It)
+    explicit Recompiler(const std::vector<unsigned char> &rom);
+
+    // The Generated C++ Source, With A main() That Times The Program If "withMain" Is Set
+    std::string source(const std::string &romName, bool withMain) const;
+
+    // What Was Recompiled
+    size_t segmentCount() const { return segments.size(); }
+    size_t instructionCount() const;                               // instructions in segments
+    size_t interpretedCount() const { return interpreted.size(); } // reachable instructions left to the interpreter
+
+private:
+    // A Straight Run Of Instructions Compiled Into One Function
+    struct Segment
+    {
+        unsigned short start;
+        unsigned short end; // one past the last instruction
+    };
+
+    // The C++ For One Instruction, Empty If It Is Left To The Interpreter, "ends" Is Set If It Leaves The Segment
+    std::string instruction(unsigned short address, unsigned short opcode, bool &ends) const;
+    std::string segmentFunction(const Segment &segment) const;
+    void formSegments();
+
+    std::vector<unsigned char> romBytes;
+    Chip8 emulator;
+    ControlFlowGraph graph;
+    std::vector<Segment> segments;
+    std::vector<unsigned short> interpreted;
+};
+
+#endif // RECOMPILER_H
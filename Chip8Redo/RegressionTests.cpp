@@ -0,0 +1,150 @@
+#include "RegressionTests.h"
+
+// Describe A Value That Is Not What It Should Be (Ending In "; " So Several Can Be Added Together), Or Return An Empty String If It Is
+static std::string expect(const std::string &what, unsigned int actual, unsigned int expected)
+{
+    if (actual == expected)
+    {
+        return "";
+    }
+    return what + " is " + toHexString(static_cast<int>(actual)) + ", expected " + toHexString(static_cast<int>(expected)) + "; ";
+}
+
+// Describe How A Run Stopped
+static std::string describe(Chip8::Fault fault, unsigned short opcode)
+{
+    return (fault == Chip8::NoFault) ? "no fault" : "\"" + Chip8::faultMessage(fault, opcode) + "\"";
+}
+
+// A Program As Large As Memory Holds, Starting With "start", Ending With "last" At 0xFFE And Zeros In Between
+static std::vector<unsigned short> fillMemory(std::vector<unsigned short> start, unsigned short last)
+{
+    start.resize((0x1000 - 0x200) / 2 - 1, 0x0000);
+    start.push_back(last);
+    return start;
+}
+
+// Every Regression Test
+std::vector<RegressionTest> regressionTests()
+{
+    return {
+        // 5xy0 And 9xy0 Must Read VY From The Third Digit (Reading It From The Last Two Read Past The Registers)
+        {"5xy0 compares VX with VY",
+         {0x6105, 0x6205, 0x5120, 0x6301, 0x6402, 0x120A},
+         10, 0x0000, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("V3", emulator.registers[0x3], 0x00) + expect("V4", emulator.registers[0x4], 0x02); }},
+        {"9xy0 compares VX with VY",
+         {0x6105, 0x6205, 0x9120, 0x6301, 0x6402, 0x120A},
+         10, 0x0000, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("V3", emulator.registers[0x3], 0x01) + expect("V4", emulator.registers[0x4], 0x02); }},
+        // 8xyE Sets VF To The Bit Shifted Out, Bit 7
+        {"8xyE sets VF to the most significant bit",
+         {0x6181, 0x821E, 0x1204},
+         10, 0x0000, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("V2", emulator.registers[0x2], 0x02) + expect("VF", emulator.registers[0xF], 0x01); }},
+        // Ex9E And ExA1 Go Through Table E, Not Table 8 (Where They Would Run As 8xyE And 8xy1)
+        {"Ex9E skips when the key in VX is pressed",
+         {0x6105, 0xE19E, 0x6301, 0x6402, 0x1208},
+         10, 0x0020, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("V1", emulator.registers[0x1], 0x05) + expect("V3", emulator.registers[0x3], 0x00) + expect("V4", emulator.registers[0x4], 0x02); }},
+        {"ExA1 skips when the key in VX is not pressed",
+         {0x6105, 0x6A30, 0xE1A1, 0x6301, 0x6402, 0x120A},
+         10, 0x0000, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("V1", emulator.registers[0x1], 0x05) + expect("V3", emulator.registers[0x3], 0x00) + expect("V4", emulator.registers[0x4], 0x02); }},
+        // There Are Only 16 Keys, So A Key Number Past 0xF Is Never Pressed
+        {"Ex9E does not skip for a key past F",
+         {0x6125, 0xE19E, 0x6301, 0x1206},
+         10, 0xFFFF, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("V3", emulator.registers[0x3], 0x01); }},
+        {"ExA1 skips for a key past F",
+         {0x6125, 0xE1A1, 0x6301, 0x6402, 0x1208},
+         10, 0xFFFF, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("V3", emulator.registers[0x3], 0x00) + expect("V4", emulator.registers[0x4], 0x02); }},
+        // subTableF Ends At 0x65, An F Opcode Past It Is Unrecognized
+        {"Fx past 65 is unrecognized",
+         {0x6001, 0xF0FF},
+         10, 0x0000, Chip8::NullOperation,
+         [](const Chip8 &emulator)
+         { return expect("V0", emulator.registers[0x0], 0x01); }},
+        // The Stack Holds 16 Return Addresses, The 17th Call Faults Instead Of Writing Past It
+        {"2nnn faults when the stack is full",
+         {0x2200},
+         100, 0x0000, Chip8::StackOverflow,
+         [](const Chip8 &emulator)
+         { return expect("SP", emulator.sp, 0x10) + expect("the last return address", emulator.stack[0xF], 0x202); }},
+        // Memory Ends At 0xFFF, So Fx33, Fx55, Fx65 And Dxyn Wrap Around To 0x000 Instead Of Reaching Past It
+        {"Fx33 wraps at the end of memory",
+         {0x60FF, 0xAFFF, 0xF033, 0x1206},
+         10, 0x0000, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("[FFF]", emulator.memory[0xFFF], 0x02) + expect("[000]", emulator.memory[0x000], 0x05) + expect("[001]", emulator.memory[0x001], 0x05); }},
+        {"Fx55 and Fx65 wrap at the end of memory",
+         {0x6012, 0x6134, 0x6256, 0xAFFE, 0xF255, 0x6000, 0x6100, 0x6200, 0xAFFE, 0xF265, 0x1214},
+         20, 0x0000, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("[000]", emulator.memory[0x000], 0x56) + expect("V0", emulator.registers[0x0], 0x12) + expect("V2", emulator.registers[0x2], 0x56); }},
+        {"Dxyn wraps at the end of memory",
+         {0x6038, 0x6100, 0xF129, 0xD011, 0x6000, 0x6105, 0xAFFF, 0xD012, 0x1210},
+         20, 0x0000, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("row 6", static_cast<unsigned int>(emulator.video[6] != 0u), 0x00) + expect("VF", emulator.registers[0xF], 0x00); }},
+        {"an instruction at 0xFFF ends at 0x000",
+         fillMemory({0x6025, 0xA000, 0xF055, 0x1FFF}, 0x0061),
+         10, 0x0000, Chip8::OutOfInstructions,
+         [](const Chip8 &emulator)
+         { return expect("V1", emulator.registers[0x1], 0x25); }},
+        // The Cycle Count Is Part Of The State (The Debugger And The Trace Database Go By It), A Faulting Instruction Does Not Count
+        {"the cycle count stops at a fault",
+         {0x6001, 0x7001, 0x7001, 0xF0FF},
+         10, 0x0000, Chip8::NullOperation,
+         [](const Chip8 &emulator)
+         { return expect("the cycle count", static_cast<unsigned int>(emulator.cycle), 0x03); }},
+        // Code A Program Overwrites Runs As It Now Is (Also In "Test Programs/Self Modifying Code" For --recompile --main)
+        {"a store changes the next instructions",
+         {0xA20A, 0x6060, 0x6177, 0xF155, 0x6200, 0x6055, 0x120C},
+         20, 0x0000, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("V0", emulator.registers[0x0], 0x77); }},
+        {"a store from a jump target changes earlier instructions",
+         {0x6000, 0x3001, 0xB210, 0x6155, 0x1208, 0x0000, 0x0000, 0x0000, 0xA206, 0x6061, 0x6177, 0xF155, 0x1206},
+         20, 0x0000, Chip8::NoFault,
+         [](const Chip8 &emulator)
+         { return expect("V1", emulator.registers[0x1], 0x77); }},
+    };
+}
+
+// Run One Test Through An Engine
+std::string runRegressionTest(const RegressionTest &test, const DiffTester::Engine &engine)
+{
+    std::vector<unsigned char> bytes;
+    for (unsigned short opcode : test.program)
+    {
+        bytes.push_back(static_cast<unsigned char>(opcode >> 8u));
+        bytes.push_back(static_cast<unsigned char>(opcode & 0x00FFu));
+    }
+
+    Chip8 emulator;
+    emulator.seedRandom(1u);
+    emulator.soundEnabled = false;
+    emulator.loadProgram(bytes.data(), bytes.size());
+    emulator.setKeys(test.keys);
+
+    Chip8::RunResult result = engine(emulator, test.instructions);
+    if (result.fault != test.fault)
+    {
+        return "stopped with " + describe(result.fault, result.opcode) + ", expected " + describe(test.fault, result.opcode);
+    }
+    std::string failure = test.check(emulator);
+    if (failure.size() >= 2)
+    {
+        failure.resize(failure.size() - 2); // the "; " after the last value
+    }
+    return failure;
+}
@@ -0,0 +1,32 @@
+#ifndef REGRESSIONTESTS_H
+#define REGRESSIONTESTS_H
+//ensure header is only declared once
+#include <functional> //For The Checks
+#include <string>     //For Test Names And Failures
+#include <vector>     //For The Programs And The List Of Tests
+#include "DiffTester.h"
+
+/*
+Short Programs That Each Pin Down One Behaviour Of The Emulator, Run Through Every Engine DiffTester Knows
+A test loads its program at 0x200 with the keypad set to "keys", runs up to "instructions" instructions and checks that it stopped
+with the expected fault (NoFault if it should run to the end) and that "check" finds the emulator as it should be.
+Chip8Redo --regress runs every test and exits with the number of failures.
+*/
+struct RegressionTest
+{
+    std::string name;
+    std::vector<unsigned short> program; // the opcodes, loaded from 0x200
+    unsigned long long instructions;
+    unsigned short keys;
+    Chip8::Fault fault;
+    // Returns An Empty String If The Emulator Ended Up As Expected, Otherwise What Was Wrong
+    std::function<std::string(const Chip8 &)> check;
+};
+
+// Every Regression Test
+std::vector<RegressionTest> regressionTests();
+
+// Run One Test Through An Engine, Returning An Empty String If It Passed, Otherwise What Was Wrong
+std::string runRegressionTest(const RegressionTest &test, const DiffTester::Engine &engine);
+
+#endif // REGRESSIONTESTS_H
@@ -0,0 +1,28 @@
+#include "RunAhead.h"
+
+// Constructor, The Copy Never Makes A Sound Or Reports To Watchpoints Or The Input Latency (Its Settings Are Never Copied Over)
+RunAhead::RunAhead()
+{
+    future.soundEnabled = false;
+}
+
+// Run A Copy Of The Emulator Ahead, Leaving The Emulator Itself Untouched
+Chip8::RunResult RunAhead::lookAhead(const Chip8 &emulator, unsigned int frames, unsigned long long instructionsPerFrame)
+{
+    future.copyState(emulator);
+    Chip8::RunResult result;
+    for (unsigned int frame = 0; frame < frames && result.ok(); frame++)
+    {
+        result = future.runInstructions(instructionsPerFrame);
+    }
+    return result;
+}
+
+// Look Ahead For The Display, Then Advance The Real Emulator By One Frame
+Chip8::RunResult RunAhead::runFrame(Chip8 &emulator, unsigned int frames, unsigned long long instructionsPerFrame)
+{
+    lookAhead(emulator, frames, instructionsPerFrame);
+    Chip8::RunResult result = emulator.runInstructions(instructionsPerFrame);
+    ++emulator.counters.frames;
+    return result;
+}
@@ -0,0 +1,33 @@
+#ifndef RUNAHEAD_H
+#define RUNAHEAD_H
+//ensure header is only declared once
+#include "Chip8.h"
+
+/*
+Hides Input Latency By Showing The Display A Few Frames Ahead Of The Emulator
+Programs read the keypad (Ex9E, ExA1) at some point in their loop and only draw the result afterwards, so a key pressed now can
+take a frame or more to show. Run-ahead takes a save state of the emulator (Chip8::copyState() into a second Chip8, about as
+fast as copying 4.5 KB), runs the copy "frames" frames further with the keys held now, and shows the copy's display. The emulator
+itself is left exactly where it was, as if the save state had been restored, and goes on to run its one real frame as normal.
+The copy runs silently, without watchpoints, without timing input latency, and its performance counters are thrown away with it.
+A fault during the look ahead just ends it early, the real frame reaches the fault itself.
+*/
+class RunAhead
+{
+public:
+    // Constructor
+    RunAhead();
+
+    // Run A Copy Of "emulator" For "frames" Frames Of "instructionsPerFrame" Instructions, Returning How The Look Ahead Ended
+    Chip8::RunResult lookAhead(const Chip8 &emulator, unsigned int frames, unsigned long long instructionsPerFrame);
+    // The Display The Last Look Ahead Reached
+    const unsigned long long *video() const { return future.video; }
+
+    // One Displayed Frame: Look "frames" Ahead, Then Run The Emulator's Real Frame (The Look Ahead's Display Is Left In video())
+    Chip8::RunResult runFrame(Chip8 &emulator, unsigned int frames, unsigned long long instructionsPerFrame);
+
+private:
+    Chip8 future;
+};
+
+#endif // RUNAHEAD_H
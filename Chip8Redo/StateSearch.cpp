@@ -0,0 +1,309 @@
+#include <algorithm>     //For Trimming The Beam
+#include <atomic>        //For Sharing Work Between Threads
+#include <chrono>        //For Timing The Search
+#include <cstring>       //For Reading Memory As Words
+#include <memory>        //For Holding The Save States
+#include <mutex>         //For Guarding The Visited Set
+#include <thread>        //For The Thread Pool
+#include <unordered_set> //For The Visited Set
+#include "StateSearch.h"
+
+namespace
+{
+    // One Emulator State In The Frontier
+    struct Node
+    {
+        std::unique_ptr<Chip8> state;
+        unsigned int parent; // index of the state this one was copied from in the previous frame
+        unsigned short input;
+        double score;
+        unsigned long long hash; // hashPackedState() of the state, unique within a frame since duplicates are dropped
+    };
+
+    // Best Score First, Ties Broken By The Hash And Then The Input Path, So The Frontier Comes Out The Same However The Threads Ran
+    bool betterNode(const Node &a, const Node &b)
+    {
+        if (a.score != b.score)
+        {
+            return a.score > b.score;
+        }
+        if (a.hash != b.hash)
+        {
+            return a.hash < b.hash;
+        }
+        if (a.parent != b.parent)
+        {
+            return a.parent < b.parent;
+        }
+        return a.input < b.input;
+    }
+
+    /* Run One Frame, Checking The Goal After Every Instruction So A State The Program Only Passes Through Mid Frame (A Program
+    Counter Most Of All) Is Not Missed. Returns The Fault That Ended The Frame Early, With "reached" Set If The Goal Was Met*/
+    Chip8::Fault runFrame(Chip8 &emulator, unsigned int instructions, const SearchGoal &goal, bool &reached)
+    {
+        reached = false;
+        for (unsigned int i = 0; i < instructions; i++)
+        {
+            Chip8::Fault fault = emulator.step();
+            if (fault != Chip8::NoFault)
+            {
+                return fault;
+            }
+            if (goal(emulator))
+            {
+                reached = true;
+                return Chip8::NoFault;
+            }
+        }
+        return Chip8::NoFault;
+    }
+
+    // How A State Was Reached, Kept For Every Frame So The Winning Input Sequence Can Be Rebuilt
+    struct Step
+    {
+        unsigned int parent;
+        unsigned short input;
+    };
+
+    // The Set Of Visited State Hashes, Split Into Shards So Threads Rarely Wait On Each Other
+    class VisitedSet
+    {
+        static constexpr int SHARDS = 64;
+        std::mutex locks[SHARDS];
+        std::unordered_set<unsigned long long> hashes[SHARDS];
+
+    public:
+        // Returns True If The Hash Was Not Already In The Set
+        bool insert(unsigned long long hash)
+        {
+            int shard = static_cast<int>(hash >> 58u);
+            std::lock_guard<std::mutex> guard(locks[shard]);
+            return hashes[shard].insert(hash).second;
+        }
+    };
+
+    // Mix One 64 Bit Word Into A Hash
+    inline unsigned long long mixWord(unsigned long long hash, unsigned long long word)
+    {
+        hash ^= word + 0x9E3779B97F4A7C15ull + (hash << 6u) + (hash >> 2u);
+        return hash * 0xFF51AFD7ED558CCDull;
+    }
+}
+
+//Constructor
+StateSearch::StateSearch(SearchGoal searchGoal, const SearchOptions &searchOptions)
+    : goal(searchGoal), options(searchOptions)
+{
+    // By Default Try Pressing Nothing And Every Key On Its Own
+    if (options.inputs.empty())
+    {
+        options.inputs.push_back(0u);
+        for (int key = 0; key < 16; key++)
+        {
+            options.inputs.push_back(static_cast<unsigned short>(1u << key));
+        }
+    }
+    if (options.threads == 0)
+    {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+// Set The Ranking Used To Trim Each Frame When Beam Search Is Enabled
+void StateSearch::setScore(SearchScore searchScore)
+{
+    score = searchScore;
+}
+
+// Goal: The Program Counter Reaches An Address
+SearchGoal StateSearch::reachPc(unsigned short address)
+{
+    return [address](const Chip8 &emulator)
+    { return emulator.pc == address; };
+}
+
+// Goal: A Memory Address Holds A Value
+SearchGoal StateSearch::memoryEquals(unsigned short address, unsigned char value)
+{
+    return [address, value](const Chip8 &emulator)
+    { return emulator.memory[address & 0x0FFFu] == value; };
+}
+
+// Hash Every Part Of The Emulator That Affects Its Future
+unsigned long long StateSearch::hashPackedState(const Chip8 &emulator)
+{
+    unsigned long long hash = 0xCBF29CE484222325ull;
+    unsigned long long word;
+
+    // Memory And Registers Are Read Eight Bytes At A Time
+    for (size_t offset = 0; offset < sizeof(emulator.memory); offset += sizeof(word))
+    {
+        std::memcpy(&word, emulator.memory + offset, sizeof(word));
+        hash = mixWord(hash, word);
+    }
+    for (size_t offset = 0; offset < sizeof(emulator.registers); offset += sizeof(word))
+    {
+        std::memcpy(&word, emulator.registers + offset, sizeof(word));
+        hash = mixWord(hash, word);
+    }
+    for (int level = 0; level < emulator.sp && level < 16; level++)
+    {
+        hash = mixWord(hash, emulator.stack[level]);
+    }
+
+    // The Display Is Packed One Bit Per Pixel, One Word Per Row
+    for (int y = 0; y < 32; y++)
+    {
+        hash = mixWord(hash, emulator.video[y]);
+    }
+
+    hash = mixWord(hash, (static_cast<unsigned long long>(emulator.pc) << 48u) | (static_cast<unsigned long long>(emulator.index) << 32u) |
+                             (static_cast<unsigned long long>(emulator.sp) << 16u) | (emulator.delayTimer << 8u) | emulator.soundTimer);
+    hash = mixWord(hash, emulator.randomState);
+    hash = mixWord(hash, (static_cast<unsigned long long>(emulator.waitingForKey) << 16u) | emulator.keyWaitMask);
+    return hash;
+}
+
+// Search Frame By Frame Until The Goal Is Reached, The Frontier Empties Or A Limit Is Hit
+SearchResult StateSearch::run(const Chip8 &start)
+{
+    SearchResult result;
+    auto startTime = std::chrono::steady_clock::now();
+    auto finish = [&result, startTime](const std::string &message)
+    {
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        result.message = message;
+        return result;
+    };
+
+    if (goal(start))
+    {
+        result.found = true;
+        return finish("The starting state already meets the goal");
+    }
+
+    VisitedSet visited;
+    visited.insert(hashPackedState(start));
+    result.statesVisited = 1;
+
+    std::vector<Node> frontier;
+    frontier.push_back({std::unique_ptr<Chip8>(new Chip8(start)), 0u, 0u, 0.0, 0u});
+    frontier[0].state->soundEnabled = false;
+    std::vector<std::vector<Step>> history(1, std::vector<Step>(1, Step{0u, 0u}));
+
+    for (unsigned int depth = 0; depth < options.maxDepth && !frontier.empty(); depth++)
+    {
+        std::atomic<size_t> nextParent(0);
+        std::atomic<bool> found(false);
+        std::atomic<unsigned long long> duplicates(0), faults(0), frames(0), visitedCount(result.statesVisited);
+        std::mutex mergeLock;
+        std::vector<Node> children;
+        Step winner{0u, 0u};
+
+        // Each Worker Takes The Next Unexpanded State And Tries Every Input On A Copy Of It
+        auto worker = [&]()
+        {
+            std::vector<Node> localChildren;
+            size_t parent;
+            while (!found && visitedCount < options.maxStates && (parent = nextParent++) < frontier.size())
+            {
+                for (unsigned short input : options.inputs)
+                {
+                    std::unique_ptr<Chip8> child(new Chip8(*frontier[parent].state));
+                    child->setKeys(input);
+                    ++frames;
+                    bool reached = false;
+                    if (runFrame(*child, options.instructionsPerFrame, goal, reached) != Chip8::NoFault)
+                    {
+                        ++faults;
+                        continue;
+                    }
+
+                    unsigned long long hash = hashPackedState(*child);
+                    if (!reached && !visited.insert(hash))
+                    {
+                        ++duplicates;
+                        continue;
+                    }
+                    ++visitedCount;
+
+                    if (reached)
+                    {
+                        std::lock_guard<std::mutex> guard(mergeLock);
+                        if (!found)
+                        {
+                            found = true;
+                            winner = Step{static_cast<unsigned int>(parent), input};
+                        }
+                        break;
+                    }
+                    double childScore = score ? score(*child) : 0.0;
+                    localChildren.push_back({std::move(child), static_cast<unsigned int>(parent), input, childScore, hash});
+                }
+            }
+
+            std::lock_guard<std::mutex> guard(mergeLock);
+            for (Node &child : localChildren)
+            {
+                children.push_back(std::move(child));
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned int i = 1; i < options.threads; i++)
+        {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (std::thread &thread : pool)
+        {
+            thread.join();
+        }
+
+        result.duplicates += duplicates;
+        result.faults += faults;
+        result.framesEmulated += frames;
+        result.statesVisited = visitedCount;
+        result.depth = depth + 1;
+
+        // Rebuild The Input Sequence By Walking Back Through Each Frame
+        if (found)
+        {
+            result.found = true;
+            result.inputs.push_back(winner.input);
+            unsigned int node = winner.parent;
+            for (unsigned int level = depth; level > 0; level--)
+            {
+                result.inputs.push_back(history[level][node].input);
+                node = history[level][node].parent;
+            }
+            std::reverse(result.inputs.begin(), result.inputs.end());
+            return finish("Goal reached after " + std::to_string(result.inputs.size()) + " frames");
+        }
+
+        // The Threads Merge Their Children In Whatever Order They Finish, So Put Them In A Fixed Order Before Beam Search
+        // Keeps Only The Best Scoring States Of The Frame
+        std::sort(children.begin(), children.end(), betterNode);
+        if (options.beamWidth > 0 && children.size() > options.beamWidth)
+        {
+            children.resize(options.beamWidth);
+        }
+
+        std::vector<Step> level;
+        level.reserve(children.size());
+        for (const Node &child : children)
+        {
+            level.push_back(Step{child.parent, child.input});
+        }
+        history.push_back(std::move(level));
+        frontier = std::move(children);
+
+        if (result.statesVisited >= options.maxStates)
+        {
+            return finish("Stopped after visiting " + std::to_string(result.statesVisited) + " states");
+        }
+    }
+
+    return finish(frontier.empty() ? "Every reachable state was explored without reaching the goal" : "Reached the maximum depth without reaching the goal");
+}
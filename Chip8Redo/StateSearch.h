@@ -0,0 +1,70 @@
+#ifndef STATESEARCH_H
+#define STATESEARCH_H
+//ensure header is only declared once
+#include <functional> //For The Goal And Score Functions
+#include <string>     //For The Result Message
+#include <vector>     //For The Input Sequences
+#include "Chip8.h"
+
+// A Condition That Ends The Search When An Emulator Reaches It, Checked After Every Instruction
+typedef std::function<bool(const Chip8 &)> SearchGoal;
+// A Ranking Used By Beam Search (Higher Is Better)
+typedef std::function<double(const Chip8 &)> SearchScore;
+
+// The Settings For A Search
+struct SearchOptions
+{
+    unsigned int instructionsPerFrame = 100; // How many instructions run between two keypad changes
+    unsigned int maxDepth = 60;              // How many frames deep the search may go
+    unsigned int beamWidth = 0;              // 0 searches breadth-first, otherwise only the best beamWidth states of each frame are kept
+    unsigned int threads = 0;                // 0 uses one thread per hardware core
+    unsigned long long maxStates = 1000000;  // Stop once this many distinct states have been visited
+    std::vector<unsigned short> inputs;      // The keypad masks tried every frame, empty tries no key plus every single key
+};
+
+// The Outcome Of A Search
+struct SearchResult
+{
+    bool found = false;
+    std::vector<unsigned short> inputs; // The keypad mask held during each frame to reach the goal
+    unsigned int depth = 0;             // The deepest frame reached
+    unsigned long long statesVisited = 0;
+    unsigned long long duplicates = 0;  // States skipped because an identical state was already visited
+    unsigned long long faults = 0;      // States that ended in an emulator exception
+    unsigned long long framesEmulated = 0;
+    double seconds = 0.0;
+    std::string message;
+};
+
+/*
+Explores Keypad Input Sequences From A Starting Save State
+Each frame every state in the frontier is copied once per input mask and run for instructionsPerFrame instructions,
+the copies are spread over a pool of threads and identical states are dropped using a hash of the packed emulator state.
+The goal is checked after every instruction, not just at the end of a frame, so a program counter passed through mid frame
+is found. The new frontier is sorted by score, then hash, then input path before beam search trims it, so the same search
+gives the same result however the threads happened to run
+*/
+class StateSearch
+{
+public:
+    // Constructor
+    StateSearch(SearchGoal searchGoal, const SearchOptions &searchOptions);
+
+    // Methods
+    void setScore(SearchScore searchScore);
+    SearchResult run(const Chip8 &start);
+
+    // Common Goals
+    static SearchGoal reachPc(unsigned short address);
+    static SearchGoal memoryEquals(unsigned short address, unsigned char value);
+
+    // Hash Every Part Of The Emulator That Affects Its Future (Memory, Registers, Stack, Timers, Display And Random State)
+    static unsigned long long hashPackedState(const Chip8 &emulator);
+
+private:
+    SearchGoal goal;
+    SearchScore score;
+    SearchOptions options;
+};
+
+#endif // STATESEARCH_H
@@ -0,0 +1,564 @@
+#include "TraceDatabase.h"
+#include <algorithm> //For Binary Searches
+#include <cctype>    //For Reading Queries
+#include <cstdlib>   //For Reading Hex Numbers
+#include <cstring>   //For Copying Registers And The Display
+#include <iomanip>   //For Writing Hex Numbers
+#include <sstream>   //For Reading And Writing Queries
+
+// Constructor, Every Address And Screen Cell Gets An Empty List
+TraceDatabase::TraceDatabase()
+    : memoryColumns(0x1000), executionColumns(0x1000), cellDraws(64 * 32)
+{
+}
+
+// Append A Cycle, Starting A New Block Every BLOCK Entries
+void TraceDatabase::Postings::push_back(uint32_t cycle)
+{
+    if (count % BLOCK == 0u)
+    {
+        firsts.push_back(cycle);
+        starts.push_back(static_cast<uint32_t>(gaps.size()));
+    }
+    else
+    {
+        // Seven Bits Of The Gap To A Byte, The Top Bit Set On Every Byte But The Last
+        uint32_t gap = cycle - last;
+        while (gap >= 0x80u)
+        {
+            gaps.push_back(static_cast<unsigned char>(gap | 0x80u));
+            gap >>= 7u;
+        }
+        gaps.push_back(static_cast<unsigned char>(gap));
+    }
+    last = cycle;
+    ++count;
+}
+
+size_t TraceDatabase::Postings::decode(size_t block, uint32_t *cycles) const
+{
+    size_t entries = std::min(BLOCK, count - block * BLOCK);
+    const unsigned char *gap = gaps.data() + starts[block];
+    uint32_t cycle = firsts[block];
+    cycles[0] = cycle;
+    for (size_t i = 1; i < entries; i++)
+    {
+        uint32_t value = 0u;
+        for (unsigned int shift = 0u;; shift += 7u)
+        {
+            unsigned char byte = *gap++;
+            value |= static_cast<uint32_t>(byte & 0x7Fu) << shift;
+            if ((byte & 0x80u) == 0u)
+            {
+                break;
+            }
+        }
+        cycle += value;
+        cycles[i] = cycle;
+    }
+    return entries;
+}
+
+// The Last Block Starting Before The Cycle Holds The Boundary, Only That One Is Decoded
+size_t TraceDatabase::Postings::countBefore(uint32_t cycle) const
+{
+    size_t blocks = std::lower_bound(firsts.begin(), firsts.end(), cycle) - firsts.begin();
+    if (blocks == 0)
+    {
+        return 0;
+    }
+    uint32_t cycles[BLOCK];
+    size_t entries = decode(blocks - 1, cycles);
+    return (blocks - 1) * BLOCK + (std::lower_bound(cycles, cycles + entries, cycle) - cycles);
+}
+
+std::vector<std::pair<size_t, uint32_t>> TraceDatabase::Postings::latest(uint32_t cycle, size_t limit) const
+{
+    std::vector<std::pair<size_t, uint32_t>> found;
+    uint32_t cycles[BLOCK];
+    for (size_t end = countBefore(cycle); end > 0 && found.size() < limit;)
+    {
+        size_t block = (end - 1) / BLOCK;
+        decode(block, cycles);
+        for (; end > block * BLOCK && found.size() < limit; end--)
+        {
+            found.emplace_back(end - 1, cycles[end - 1 - block * BLOCK]);
+        }
+    }
+    return found;
+}
+
+// Drop Whole Blocks, Then Append The Entries Kept From A Block That Was Cut Part Way
+void TraceDatabase::Postings::truncate(size_t keep)
+{
+    if (keep >= count)
+    {
+        return;
+    }
+    size_t block = keep / BLOCK;
+    uint32_t cycles[BLOCK];
+    if (keep % BLOCK != 0u)
+    {
+        decode(block, cycles);
+    }
+    gaps.resize(starts[block]);
+    firsts.resize(block);
+    starts.resize(block);
+    count = block * BLOCK;
+    last = 0u;
+    if (count > 0u)
+    {
+        uint32_t previous[BLOCK];
+        last = previous[decode(block - 1, previous) - 1];
+    }
+    for (size_t i = 0; i < keep % BLOCK; i++)
+    {
+        push_back(cycles[i]);
+    }
+}
+
+// Drop The Entries Of A Column From Cycle "cycle" On
+void TraceDatabase::Column::truncate(uint32_t cycle)
+{
+    size_t keep = cycles.countBefore(cycle);
+    cycles.truncate(keep);
+    values.resize(keep);
+}
+
+void TraceDatabase::clear()
+{
+    startCycle = 0;
+    length = 0;
+    for (Column &column : registerColumns)
+    {
+        column = Column();
+    }
+    indexValues.clear();
+    for (Column &column : memoryColumns)
+    {
+        column = Column();
+    }
+    for (Postings &cycles : executionColumns)
+    {
+        cycles = Postings();
+    }
+    std::vector<Draw>().swap(draws);
+    for (Postings &positions : cellDraws)
+    {
+        positions = Postings();
+    }
+    std::vector<uint32_t>().swap(keyCycles);
+    std::vector<unsigned short>().swap(keyMasks);
+    checkpoints.clear();
+}
+
+// The First Checkpoint Is The Emulator As It Is Now, Before Any Instruction Is Recorded
+void TraceDatabase::start(const Chip8 &emulator)
+{
+    clear();
+    startCycle = emulator.cycle;
+    checkpoints.emplace_back(new Chip8());
+    checkpoints.back()->soundEnabled = false;
+    checkpoints.back()->copyState(emulator);
+}
+
+// Drop Everything Recorded From Cycle "cycle" On, Keeping The Checkpoint At It If There Is One
+void TraceDatabase::truncate(unsigned long long cycle)
+{
+    uint32_t offset = offsetOf(cycle);
+    for (Column &column : registerColumns)
+    {
+        column.truncate(offset);
+    }
+    for (auto &value : indexValues)
+    {
+        value.second.truncate(value.second.countBefore(offset));
+    }
+    for (Column &column : memoryColumns)
+    {
+        column.truncate(offset);
+    }
+    for (Postings &cycles : executionColumns)
+    {
+        cycles.truncate(cycles.countBefore(offset));
+    }
+    while (!draws.empty() && draws.back().cycle >= cycle)
+    {
+        draws.pop_back();
+    }
+    for (Postings &positions : cellDraws)
+    {
+        positions.truncate(positions.countBefore(static_cast<uint32_t>(draws.size())));
+    }
+    size_t keys = std::lower_bound(keyCycles.begin(), keyCycles.end(), offset) - keyCycles.begin();
+    keyCycles.resize(keys);
+    keyMasks.resize(keys);
+    checkpoints.resize(std::min<size_t>(checkpoints.size(), offset / CHECKPOINT_INTERVAL + 1u));
+    length = offset;
+}
+
+// Execute One Instruction, Then Add Whatever It Changed To The Columns
+Chip8::Fault TraceDatabase::step(Chip8 &emulator)
+{
+    // Carry On From The End Of The Trace, Go Back Into It, Or Start A New One If The Emulator Is Somewhere Else Entirely
+    unsigned long long cycle = emulator.cycle;
+    if (empty() || cycle < startCycle || cycle > endCycle() || cycle - startCycle >= MAX_INSTRUCTIONS)
+    {
+        start(emulator);
+    }
+    else if (cycle < endCycle())
+    {
+        truncate(cycle);
+    }
+    uint32_t offset = static_cast<uint32_t>(cycle - startCycle);
+
+    // The Keypad Is Read Once, So The Checkpoint And The Recorded Keys Agree Even If The GUI Changes It Meanwhile
+    unsigned short keypad = emulator.keypad.load();
+    if (offset % CHECKPOINT_INTERVAL == 0u && offset / CHECKPOINT_INTERVAL == checkpoints.size())
+    {
+        checkpoints.emplace_back(new Chip8());
+        checkpoints.back()->soundEnabled = false;
+        checkpoints.back()->copyState(emulator);
+        checkpoints.back()->keypad.store(keypad);
+    }
+    if (keyMasks.empty() || keyMasks.back() != keypad)
+    {
+        keyCycles.push_back(offset);
+        keyMasks.push_back(keypad);
+    }
+
+    // Remember What The Instruction Could Change
+    unsigned short pc = emulator.pc;
+    unsigned short index = emulator.index;
+    unsigned short opcode = (emulator.memory[pc & 0x0FFFu] << 8u) | emulator.memory[(pc + 1) & 0x0FFFu];
+    unsigned char registers[16];
+    std::memcpy(registers, emulator.registers, sizeof(registers));
+    bool drawing = (opcode & 0xF000u) == 0xD000u;
+    unsigned long long video[32];
+    if (drawing)
+    {
+        std::memcpy(video, emulator.video, sizeof(video));
+    }
+
+    Chip8::Fault fault = emulator.step();
+    if (fault != Chip8::NoFault)
+    {
+        return fault;
+    }
+
+    executionColumns[pc & 0x0FFFu].push_back(offset);
+    for (int i = 0; i < 16; i++)
+    {
+        if (emulator.registers[i] != registers[i])
+        {
+            registerColumns[i].append(offset, emulator.registers[i]);
+        }
+    }
+    if (emulator.index != index)
+    {
+        registerColumns[INDEX_TARGET].append(offset, emulator.index);
+        indexValues[emulator.index].push_back(offset);
+    }
+
+    // Fx33 And Fx55 Are The Only Instructions That Store To Memory, Both Starting At The Index Register
+    unsigned int stored = ((opcode & 0xF0FFu) == 0xF033u) ? 3u : ((opcode & 0xF0FFu) == 0xF055u) ? ((opcode & 0x0F00u) >> 8u) + 1u : 0u;
+    for (unsigned int i = 0; i < stored; i++)
+    {
+        unsigned short address = (index + i) & 0x0FFFu;
+        memoryColumns[address].append(offset, emulator.memory[address]);
+    }
+
+    // A Draw Is Filed Under Every Cell Whose Pixel It Toggled
+    if (drawing)
+    {
+        Draw draw;
+        draw.cycle = cycle;
+        draw.pc = pc;
+        draw.address = index;
+        draw.x = registers[(opcode & 0x0F00u) >> 8u] % 64u;
+        draw.y = registers[(opcode & 0x00F0u) >> 4u] % 32u;
+        draw.height = opcode & 0x000Fu;
+        draw.collision = emulator.registers[0xF] != 0u;
+        uint32_t position = static_cast<uint32_t>(draws.size());
+        draws.push_back(draw);
+        for (unsigned int y = 0; y < 32; y++)
+        {
+            unsigned long long toggled = video[y] ^ emulator.video[y];
+            for (unsigned int x = 0; toggled != 0u; x++, toggled <<= 1u)
+            {
+                if ((toggled >> 63u) != 0u)
+                {
+                    cellDraws[y * 64u + x].push_back(position);
+                }
+            }
+        }
+    }
+
+    length = offset + 1u;
+    return Chip8::NoFault;
+}
+
+size_t TraceDatabase::memoryUsage() const
+{
+    size_t bytes = sizeof(*this);
+    for (const Column &column : registerColumns)
+    {
+        bytes += column.bytes();
+    }
+    for (const auto &value : indexValues)
+    {
+        bytes += sizeof(value) + value.second.bytes();
+    }
+    for (const Column &column : memoryColumns)
+    {
+        bytes += sizeof(column) + column.bytes();
+    }
+    for (const Postings &cycles : executionColumns)
+    {
+        bytes += sizeof(cycles) + cycles.bytes();
+    }
+    bytes += draws.capacity() * sizeof(Draw);
+    for (const Postings &positions : cellDraws)
+    {
+        bytes += sizeof(positions) + positions.bytes();
+    }
+    bytes += keyCycles.capacity() * sizeof(uint32_t) + keyMasks.capacity() * sizeof(unsigned short);
+    bytes += checkpoints.size() * sizeof(Chip8);
+    return bytes;
+}
+
+uint32_t TraceDatabase::offsetOf(unsigned long long cycle) const
+{
+    if (cycle <= startCycle)
+    {
+        return 0u;
+    }
+    return static_cast<uint32_t>(std::min(cycle - startCycle, MAX_INSTRUCTIONS));
+}
+
+std::vector<TraceDatabase::Write> TraceDatabase::latest(const Column &column, unsigned long long before, size_t limit) const
+{
+    std::vector<Write> found;
+    for (const auto &entry : column.cycles.latest(offsetOf(before), limit))
+    {
+        found.push_back({startCycle + entry.second, column.values[entry.first]});
+    }
+    return found;
+}
+
+std::vector<unsigned long long> TraceDatabase::latest(const Postings &cycles, unsigned long long before, size_t limit) const
+{
+    std::vector<unsigned long long> found;
+    for (const auto &entry : cycles.latest(offsetOf(before), limit))
+    {
+        found.push_back(startCycle + entry.second);
+    }
+    return found;
+}
+
+bool TraceDatabase::lastRegisterChange(int target, unsigned long long before, Write &change) const
+{
+    std::vector<Write> found = latest(registerColumns[std::min(target, INDEX_TARGET)], before, 1);
+    if (found.empty())
+    {
+        return false;
+    }
+    change = found.front();
+    return true;
+}
+
+bool TraceDatabase::lastMemoryWrite(unsigned short address, unsigned long long before, Write &write) const
+{
+    std::vector<Write> found = latest(memoryColumns[address & 0x0FFFu], before, 1);
+    if (found.empty())
+    {
+        return false;
+    }
+    write = found.front();
+    return true;
+}
+
+bool TraceDatabase::lastExecution(unsigned short address, unsigned long long before, unsigned long long &cycle) const
+{
+    std::vector<unsigned long long> found = latest(executionColumns[address & 0x0FFFu], before, 1);
+    if (found.empty())
+    {
+        return false;
+    }
+    cycle = found.front();
+    return true;
+}
+
+// The Latest Change Before The Cycle, Or The Value The Trace Started With If It Had Not Changed Yet
+unsigned short TraceDatabase::registerAt(int target, unsigned long long cycle) const
+{
+    Write change;
+    if (lastRegisterChange(target, cycle, change))
+    {
+        return change.value;
+    }
+    if (empty())
+    {
+        return 0u;
+    }
+    return (target >= INDEX_TARGET) ? checkpoints.front()->index : checkpoints.front()->registers[target & 0xF];
+}
+
+std::vector<TraceDatabase::Write> TraceDatabase::registerChanges(int target, unsigned long long before, size_t limit) const
+{
+    return latest(registerColumns[std::min(target, INDEX_TARGET)], before, limit);
+}
+
+std::vector<unsigned long long> TraceDatabase::indexSetTo(unsigned short value, unsigned long long before, size_t limit) const
+{
+    auto cycles = indexValues.find(value);
+    return (cycles == indexValues.end()) ? std::vector<unsigned long long>() : latest(cycles->second, before, limit);
+}
+
+std::vector<TraceDatabase::Write> TraceDatabase::memoryWrites(unsigned short address, unsigned long long before, size_t limit) const
+{
+    return latest(memoryColumns[address & 0x0FFFu], before, limit);
+}
+
+std::vector<unsigned long long> TraceDatabase::executions(unsigned short address, unsigned long long before, size_t limit) const
+{
+    return latest(executionColumns[address & 0x0FFFu], before, limit);
+}
+
+size_t TraceDatabase::executionCount(unsigned short address, unsigned long long before) const
+{
+    return executionColumns[address & 0x0FFFu].countBefore(offsetOf(before));
+}
+
+std::vector<TraceDatabase::Draw> TraceDatabase::drawsAt(unsigned int x, unsigned int y, unsigned long long before, size_t limit) const
+{
+    // The Draws Are Filed In The Order They Happened, So Only Those Numbered Below The First Draw At "before" Count
+    uint32_t drawsBefore = static_cast<uint32_t>(std::lower_bound(draws.begin(), draws.end(), before,
+                                                                  [](const Draw &draw, unsigned long long cycle) { return draw.cycle < cycle; }) - draws.begin());
+    std::vector<Draw> found;
+    for (const auto &entry : cellDraws[(y % 32u) * 64u + (x % 64u)].latest(drawsBefore, limit))
+    {
+        found.push_back(draws[entry.second]);
+    }
+    return found;
+}
+
+// Read A Word Of A Query As A Hex Number
+static bool readHex(const std::string &word, unsigned int &value)
+{
+    char *end = nullptr;
+    value = static_cast<unsigned int>(std::strtoul(word.c_str(), &end, 16));
+    return !word.empty() && *end == '\0';
+}
+
+// Write A Number In Upper Case Hex, Padded With Zeroes
+static std::string hex(unsigned int value, int digits)
+{
+    std::ostringstream text;
+    text << std::uppercase << std::hex << std::setw(digits) << std::setfill('0') << value;
+    return text.str();
+}
+
+std::vector<TraceDatabase::Hit> TraceDatabase::query(const std::string &text, unsigned long long before, size_t limit, std::string &error) const
+{
+    std::istringstream stream(text);
+    std::vector<std::string> words;
+    std::string word;
+    while (stream >> word)
+    {
+        for (char &letter : word)
+        {
+            letter = static_cast<char>(std::toupper(static_cast<unsigned char>(letter)));
+        }
+        words.push_back(word);
+    }
+
+    std::vector<Hit> hits;
+    unsigned int first = 0u;
+    unsigned int second = 0u;
+    bool isRegister = words.size() == 1u && (words[0] == "I" || (words[0].size() == 2u && words[0][0] == 'V' && std::isxdigit(static_cast<unsigned char>(words[0][1]))));
+    if (isRegister)
+    {
+        int target = (words[0] == "I") ? INDEX_TARGET : static_cast<int>(std::strtoul(words[0].c_str() + 1, nullptr, 16));
+        for (const Write &change : registerChanges(target, before, limit))
+        {
+            hits.push_back({change.cycle, "cycle " + std::to_string(change.cycle) + "  " + words[0] + " = " + hex(change.value, (target == INDEX_TARGET) ? 3 : 2)});
+        }
+    }
+    else if (words.size() == 2u && words[0] == "I" && readHex(words[1], first))
+    {
+        for (unsigned long long cycle : indexSetTo(static_cast<unsigned short>(first), before, limit))
+        {
+            hits.push_back({cycle, "cycle " + std::to_string(cycle) + "  I = " + hex(first, 3)});
+        }
+    }
+    else if (words.size() == 2u && words[0] == "PC" && readHex(words[1], first))
+    {
+        for (unsigned long long cycle : executions(static_cast<unsigned short>(first), before, limit))
+        {
+            hits.push_back({cycle, "cycle " + std::to_string(cycle) + "  PC " + hex(first & 0x0FFFu, 3)});
+        }
+    }
+    else if (words.size() == 2u && words[0] == "M" && readHex(words[1], first))
+    {
+        for (const Write &write : memoryWrites(static_cast<unsigned short>(first), before, limit))
+        {
+            hits.push_back({write.cycle, "cycle " + std::to_string(write.cycle) + "  M " + hex(first & 0x0FFFu, 3) + " = " + hex(write.value, 2)});
+        }
+    }
+    else if (words.size() == 3u && words[0] == "DRAW" && readHex(words[1], first) && readHex(words[2], second))
+    {
+        for (const Draw &draw : drawsAt(first, second, before, limit))
+        {
+            hits.push_back({draw.cycle, "cycle " + std::to_string(draw.cycle) + "  PC " + hex(draw.pc, 3) + "  DRW " + hex(draw.x, 2) + "," + hex(draw.y, 2) + " " +
+                                            std::to_string(draw.height) + " rows from " + hex(draw.address, 3) + (draw.collision ? "  collision" : "")});
+        }
+    }
+    else
+    {
+        error = "Queries are V0 - VF, I, I address, PC address, M address or DRAW x y (in hex)";
+    }
+    return hits;
+}
+
+// Restore The Checkpoint Before The Cycle, Then Replay Up To It With The Keys That Were Pressed
+bool TraceDatabase::seek(Chip8 &emulator, unsigned long long cycle) const
+{
+    if (empty() || cycle < startCycle || cycle > endCycle())
+    {
+        return false;
+    }
+    uint32_t offset = static_cast<uint32_t>(cycle - startCycle);
+    size_t checkpoint = std::min<size_t>(offset / CHECKPOINT_INTERVAL, checkpoints.size() - 1u);
+
+    // The Replay Is Silent And Does Not Report To Watchpoints Or Time Input Latency (Those Already Happened)
+    bool soundEnabled = emulator.soundEnabled;
+    Watchpoints *watchpoints = emulator.watchpoints;
+    InputLatency *inputLatency = emulator.inputLatency;
+    emulator.soundEnabled = false;
+    emulator.watchpoints = nullptr;
+    emulator.inputLatency = nullptr;
+
+    emulator.copyState(*checkpoints[checkpoint]);
+    uint32_t at = static_cast<uint32_t>(checkpoint * CHECKPOINT_INTERVAL);
+    size_t key = std::lower_bound(keyCycles.begin(), keyCycles.end(), at) - keyCycles.begin();
+    bool replayed = true;
+    while (replayed)
+    {
+        if (key < keyCycles.size() && keyCycles[key] == at)
+        {
+            emulator.keypad.store(keyMasks[key++]);
+        }
+        if (at == offset)
+        {
+            break;
+        }
+        replayed = emulator.step() == Chip8::NoFault;
+        ++at;
+    }
+
+    emulator.soundEnabled = soundEnabled;
+    emulator.watchpoints = watchpoints;
+    emulator.inputLatency = inputLatency;
+    return replayed;
+}
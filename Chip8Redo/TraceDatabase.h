@@ -0,0 +1,172 @@
+#ifndef TRACEDATABASE_H
+#define TRACEDATABASE_H
+//ensure header is only declared once
+#include <cstdint>       //For The 32 Bit Cycle Offsets
+#include <memory>        //For The Checkpoints
+#include <string>        //For Queries
+#include <unordered_map> //For The Index Register's Values
+#include <utility>       //For Entries Found With Their Positions
+#include <vector>        //For The Columns
+#include "Chip8.h"
+
+/*
+A Recording Of Everything A Program Did, Indexed So Its History Can Be Searched And Revisited
+Instead of a log of every instruction (which at hundreds of millions of instructions is far too large to search), step() keeps
+columns that answer each kind of question directly, every one sorted by cycle as it is appended:
+ - a change list for each of V0 - VF and I (the cycle and the new value, only when the value really changed)
+ - the cycles I was set to each value, for "every time I pointed at 0x2A0"
+ - a write list for each memory address (every byte Fx33 and Fx55 stored, changed or not)
+ - the cycles each address was executed at
+ - every draw, and for each of the 64 x 32 screen cells the draws that toggled it
+ - the keypad whenever it changed, and a checkpoint of the whole emulator (Chip8::copyState()) every CHECKPOINT_INTERVAL instructions
+A cycle here is the emulator's Chip8::cycle when the instruction started, so an entry at cycle C was made by the instruction that
+ran from cycle C to C + 1. Questions are a binary search into one column, taking microseconds however long the trace is, and
+seek() travels to any recorded cycle by restoring the checkpoint before it and replaying at most CHECKPOINT_INTERVAL instructions
+with the recorded keys, which reproduces the emulator exactly (its random numbers are part of its state).
+Cycles are stored as 32 bit offsets from the start of the trace, which is restarted once it reaches MAX_INSTRUCTIONS. Recording
+an instruction at an earlier cycle than the trace reached (after seeking back and running on) drops the recorded future first,
+and an instruction outside the recorded range starts a new trace. A newly loaded program starts again from cycle 0, which step()
+cannot tell apart from seeking back, so whoever loads or closes a program calls clear() as well.
+*/
+class TraceDatabase
+{
+public:
+    static constexpr int INDEX_TARGET = 16; // the change list after V0 - VF is the index register's (as in Debugger::Condition)
+    static constexpr unsigned int CHECKPOINT_INTERVAL = 1u << 16u;
+    static constexpr unsigned long long MAX_INSTRUCTIONS = 0xFFFFFFFFull;
+
+    // A Value Written To A Register Or Memory, And The Cycle Of The Instruction That Wrote It
+    struct Write
+    {
+        unsigned long long cycle;
+        unsigned short value;
+    };
+
+    // One Sprite Drawn By Dxyn, Where It Was Drawn From And What It Hit
+    struct Draw
+    {
+        unsigned long long cycle;
+        unsigned short pc;
+        unsigned short address; // the index register, where the sprite was read from
+        unsigned char x, y;     // the screen cell of the sprite's top left pixel
+        unsigned char height;
+        bool collision;
+    };
+
+    // One Answer To query(), With The Cycle To seek() To For It
+    struct Hit
+    {
+        unsigned long long cycle;
+        std::string text;
+    };
+
+    // Constructor
+    TraceDatabase();
+
+    // Recording
+    // Forget Everything And Start A New Trace At The Emulator's Current State
+    void start(const Chip8 &emulator);
+    void clear();
+    // Execute One Instruction With Chip8::step(), Recording What It Did (A Faulting Instruction Is Not Recorded)
+    Chip8::Fault step(Chip8 &emulator);
+    bool empty() const { return checkpoints.empty(); }
+    unsigned long long firstCycle() const { return startCycle; }
+    unsigned long long endCycle() const { return startCycle + length; } // one past the last recorded instruction
+    size_t memoryUsage() const;
+
+    // Questions, Each Looking Only At Instructions Before Cycle "before"
+    // The Latest Change To A Register (0x0 - 0xF Or INDEX_TARGET) Or Write To A Memory Address, False If There Was None
+    bool lastRegisterChange(int target, unsigned long long before, Write &change) const;
+    bool lastMemoryWrite(unsigned short address, unsigned long long before, Write &write) const;
+    // The Latest Time The Instruction At "address" Was Executed, False If It Never Was
+    bool lastExecution(unsigned short address, unsigned long long before, unsigned long long &cycle) const;
+    // The Value A Register Held At The Start Of Cycle "cycle" (firstCycle() - endCycle())
+    unsigned short registerAt(int target, unsigned long long cycle) const;
+    // Each Of These Lists The Latest "limit" Entries, The Latest First
+    std::vector<Write> registerChanges(int target, unsigned long long before, size_t limit) const;
+    std::vector<unsigned long long> indexSetTo(unsigned short value, unsigned long long before, size_t limit) const;
+    std::vector<Write> memoryWrites(unsigned short address, unsigned long long before, size_t limit) const;
+    std::vector<unsigned long long> executions(unsigned short address, unsigned long long before, size_t limit) const;
+    std::vector<Draw> drawsAt(unsigned int x, unsigned int y, unsigned long long before, size_t limit) const;
+    // How Many Times The Instruction At "address" Was Executed Before "before"
+    size_t executionCount(unsigned short address, unsigned long long before) const;
+
+    /* Answer A Question Written As Text (Numbers In Hex), The Latest First, Or Set "error" If It Cannot Be Read:
+    "V3" or "I" for every change to a register, "I 2A0" for every time I was set to 0x2A0, "PC 2A0" for every time 0x2A0
+    was executed, "M 300" for every write to 0x300 and "DRAW 10 5" for every draw that toggled the pixel at x 0x10, y 5*/
+    std::vector<Hit> query(const std::string &text, unsigned long long before, size_t limit, std::string &error) const;
+
+    // Time Travel
+    // Put The Emulator In The State It Was In At The Start Of Cycle "cycle" (firstCycle() - endCycle()), False If It Was Not Recorded
+    bool seek(Chip8 &emulator, unsigned long long cycle) const;
+
+private:
+    /* A Sorted List Of Cycles (As Offsets From startCycle), Stored As The Gaps Between Them
+    Most gaps are small (a loop executes the same address every few cycles), so each is written in as few bytes as it needs,
+    seven bits to a byte. The list is cut into blocks of BLOCK entries whose first cycles are kept whole, so finding a cycle is
+    a binary search over the blocks followed by decoding one of them.*/
+    class Postings
+    {
+    public:
+        static constexpr size_t BLOCK = 64;
+
+        void push_back(uint32_t cycle);
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        uint32_t back() const { return last; }
+        // How Many Entries Are Before "cycle"
+        size_t countBefore(uint32_t cycle) const;
+        // The Latest "limit" Entries Before "cycle" (The Latest First), With Their Positions In The List
+        std::vector<std::pair<size_t, uint32_t>> latest(uint32_t cycle, size_t limit) const;
+        // Keep Only The First "keep" Entries
+        void truncate(size_t keep);
+        size_t bytes() const { return firsts.capacity() * sizeof(uint32_t) + starts.capacity() * sizeof(uint32_t) + gaps.capacity(); }
+
+    private:
+        // Write The Entries Of A Block Into "cycles" (Which Has Room For BLOCK), Returning How Many There Are
+        size_t decode(size_t block, uint32_t *cycles) const;
+
+        std::vector<uint32_t> firsts;     // the first cycle of each block
+        std::vector<uint32_t> starts;     // where each block's gaps start in gaps
+        std::vector<unsigned char> gaps;  // the gap before every entry that is not first in its block
+        size_t count = 0;
+        uint32_t last = 0;
+    };
+
+    // Cycles And The Values Written At Them, Side By Side
+    struct Column
+    {
+        Postings cycles;
+        std::vector<unsigned short> values;
+
+        void append(uint32_t cycle, unsigned short value)
+        {
+            cycles.push_back(cycle);
+            values.push_back(value);
+        }
+        void truncate(uint32_t cycle);
+        size_t bytes() const { return cycles.bytes() + values.capacity() * sizeof(unsigned short); }
+    };
+
+    // Drop Everything Recorded From Cycle "cycle" On
+    void truncate(unsigned long long cycle);
+    // A Cycle As An Offset From startCycle, Clamped To The Offsets A Trace Can Hold
+    uint32_t offsetOf(unsigned long long cycle) const;
+    // The Latest "limit" Writes In A Column Before "before", The Latest First
+    std::vector<Write> latest(const Column &column, unsigned long long before, size_t limit) const;
+    std::vector<unsigned long long> latest(const Postings &cycles, unsigned long long before, size_t limit) const;
+
+    unsigned long long startCycle = 0;
+    unsigned long long length = 0;                            // instructions recorded
+    Column registerColumns[17];                               // V0 - VF, then I
+    std::unordered_map<unsigned short, Postings> indexValues; // the cycles I was set to each value
+    std::vector<Column> memoryColumns;                        // one for each address
+    std::vector<Postings> executionColumns;                   // one for each address
+    std::vector<Draw> draws;
+    std::vector<Postings> cellDraws;                 // positions in draws, for each cell from the top left along each row
+    std::vector<uint32_t> keyCycles;                 // the instructions that saw the keypad change
+    std::vector<unsigned short> keyMasks;            // and the keypad they saw
+    std::vector<std::unique_ptr<Chip8>> checkpoints; // the state at startCycle + n * CHECKPOINT_INTERVAL
+};
+
+#endif // TRACEDATABASE_H
@@ -0,0 +1,49 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+//ensure header is only declared once
+#include <atomic> //For Swapping Slots Without Locks
+
+/*
+Hands The Latest Value From One Producer Thread To One Consumer Thread Without Locks Or Waiting
+The producer always has a slot of its own to fill and the consumer always has a slot of its own to read, the third slot sits
+between them. Publishing swaps the filled slot into the middle, taking whatever was there, and the consumer swaps the middle
+slot out only when something new was published, so the consumer only ever sees the most recent value and neither side blocks.
+*/
+template <typename T>
+class TripleBuffer
+{
+public:
+    // The Slot The Producer Fills Next
+    T &back() { return slots[backIndex]; }
+
+    // Make The Filled Slot The Latest Value
+    void publish()
+    {
+        backIndex = middle.exchange(backIndex | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Take The Latest Value If One Was Published Since The Last Call, Returns False If front() Is Unchanged
+    bool update()
+    {
+        if ((middle.load(std::memory_order_relaxed) & FRESH) == 0)
+        {
+            return false;
+        }
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    // The Slot The Consumer Reads
+    const T &front() const { return slots[frontIndex]; }
+
+private:
+    static constexpr int INDEX = 3; // the low bits of "middle" hold the slot index
+    static constexpr int FRESH = 4; // set when the middle slot holds a value the consumer has not taken
+
+    T slots[3]{};
+    std::atomic<int> middle{1};
+    int backIndex = 0;  // only touched by the producer
+    int frontIndex = 2; // only touched by the consumer
+};
+
+#endif // TRIPLEBUFFER_H
@@ -0,0 +1,273 @@
+#include <algorithm> //For Clamping The Scale
+#include <cstring>   //For Repeating Rows
+#include "Upscaler.h"
+
+namespace
+{
+// Every Pixel's Left Or Right Neighbour, Pixels On The Edge Of The Display Use Themselves
+inline unsigned long long leftOf(unsigned long long row) { return (row >> 1u) | (row & 0x8000000000000000ull); }
+inline unsigned long long rightOf(unsigned long long row) { return (row << 1u) | (row & 1ull); }
+
+// Bitwise Forms Of The Filter Rules, Each Bit Answers The Question For One Pixel
+inline unsigned long long same(unsigned long long a, unsigned long long b) { return ~(a ^ b); }
+inline unsigned long long select(unsigned long long condition, unsigned long long a, unsigned long long b) { return (condition & a) | (~condition & b); }
+
+// The Eight Neighbours Of Every Pixel In A Row, Named As In The Scale2x Description
+//  A B C
+//  D E F
+//  G H I
+struct Neighbourhood
+{
+    unsigned long long a, b, c, d, e, f, g, h, i;
+
+    Neighbourhood(const unsigned long long rows[32], int y)
+    {
+        unsigned long long above = rows[(y > 0) ? y - 1 : y];
+        unsigned long long below = rows[(y < 31) ? y + 1 : y];
+        a = leftOf(above);
+        b = above;
+        c = rightOf(above);
+        d = leftOf(rows[y]);
+        e = rows[y];
+        f = rightOf(rows[y]);
+        g = leftOf(below);
+        h = below;
+        i = rightOf(below);
+    }
+
+    // The Scale2x Tests, Set Where A Diagonal Edge Cuts Across That Corner Of The Pixel
+    unsigned long long topLeft() const { return same(b, d) & (b ^ f) & (d ^ h); }
+    unsigned long long topRight() const { return same(b, f) & (b ^ d) & (f ^ h); }
+    unsigned long long bottomLeft() const { return same(d, h) & (d ^ b) & (h ^ f); }
+    unsigned long long bottomRight() const { return same(h, f) & (d ^ h) & (b ^ f); }
+};
+}
+
+// Eight Bits To Eight Bytes Of 0 Or 1, The Highest Bit Going To The First Byte In Memory (For A Little Endian Processor)
+const Upscaler::SpreadTable Upscaler::byteSpread;
+
+Upscaler::SpreadTable::SpreadTable()
+{
+    for (unsigned int bits = 0; bits < 256; bits++)
+    {
+        unsigned long long bytes = 0u;
+        for (unsigned int k = 0; k < 8; k++)
+        {
+            bytes |= static_cast<unsigned long long>((bits >> (7 - k)) & 1u) << (8 * k);
+        }
+        spread[bits] = bytes;
+    }
+}
+
+//Constructor
+Upscaler::Upscaler()
+{
+    setFilter(Nearest, 1);
+}
+
+// Size The Output Buffer For A Filter, This Is The Only Place It Allocates
+void Upscaler::setFilter(Filter filter, int scale)
+{
+    current = filter;
+    filterFactor = (filter == Scale2x || filter == HQ2x) ? 2 : (filter == Scale3x) ? 3 : 1;
+    repeat = std::max(1, scale / filterFactor);
+    pixels.assign(static_cast<size_t>(width()) * height(), 0u);
+}
+
+const unsigned char *Upscaler::scale(const unsigned long long rows[32])
+{
+    switch (current)
+    {
+    case Nearest:
+        nearest(rows);
+        break;
+    case Scale2x:
+        scale2x(rows);
+        break;
+    case Scale3x:
+        scale3x(rows);
+        break;
+    case HQ2x:
+        hq2x(rows);
+        break;
+    }
+    return pixels.data();
+}
+
+const char *Upscaler::name(Filter filter)
+{
+    switch (filter)
+    {
+    case Nearest:
+        return "nearest";
+    case Scale2x:
+        return "scale2x";
+    case Scale3x:
+        return "scale3x";
+    case HQ2x:
+        return "hq2x";
+    }
+    return "";
+}
+
+bool Upscaler::filterNamed(const std::string &filterName, Filter &filter)
+{
+    for (Filter candidate : {Nearest, Scale2x, Scale3x, HQ2x})
+    {
+        if (filterName == name(candidate))
+        {
+            filter = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Expand The Bits Of One Phase Into Levels, Eight Pixels At A Time
+void Upscaler::put(int phase, unsigned long long lit, unsigned long long corner, unsigned long long half)
+{
+    unsigned char *levels = phaseLevels[phase];
+    for (int group = 0; group < 8; group++)
+    {
+        int shift = 56 - group * 8;
+        unsigned int litBits = (lit >> shift) & 0xFFu;
+        unsigned int cornerBits = (corner >> shift) & 0xFFu;
+        unsigned int halfBits = (half >> shift) & 0xFFu;
+        // A Corner Moves The Level A Quarter Towards The Other Color, An Edge Half Way (Each Byte Ends Up 0 - 4, So No Byte Borrows From Its Neighbour)
+        unsigned long long raised = LIT * byteSpread[litBits] + byteSpread[cornerBits] + 2 * byteSpread[halfBits];
+        unsigned long long lowered = 2 * byteSpread[cornerBits & litBits] + LIT * byteSpread[halfBits & litBits];
+        unsigned long long eight = raised - lowered;
+        std::memcpy(levels + group * 8, &eight, sizeof(eight));
+    }
+
+}
+
+// Interleave The Phases Of An Output Row, Repeating Each Pixel Across, And Copy It Down
+void Upscaler::writeRow(int filterRow)
+{
+    unsigned char *out = pixels.data() + static_cast<size_t>(filterRow) * repeat * width();
+    if (repeat == 1)
+    {
+        // The Common Cases Have A Fixed Stride The Compiler Can Vectorise
+        switch (filterFactor)
+        {
+        case 1:
+            std::memcpy(out, phaseLevels[0], 64);
+            return;
+        case 2:
+            interleave<2>(out);
+            return;
+        case 3:
+            interleave<3>(out);
+            return;
+        }
+    }
+    for (int x = 0; x < 64; x++)
+    {
+        for (int phase = 0; phase < filterFactor; phase++)
+        {
+            unsigned char level = phaseLevels[phase][x];
+            for (int r = 0; r < repeat; r++)
+            {
+                *out++ = level;
+            }
+        }
+    }
+    repeatRow(filterRow);
+}
+
+template <int Factor>
+void Upscaler::interleave(unsigned char *out) const
+{
+    for (int x = 0; x < 64; x++)
+    {
+        for (int phase = 0; phase < Factor; phase++)
+        {
+            out[x * Factor + phase] = phaseLevels[phase][x];
+        }
+    }
+}
+
+void Upscaler::repeatRow(int filterRow)
+{
+    size_t rowBytes = static_cast<size_t>(width());
+    unsigned char *first = pixels.data() + static_cast<size_t>(filterRow) * repeat * rowBytes;
+    for (int r = 1; r < repeat; r++)
+    {
+        std::memcpy(first + r * rowBytes, first, rowBytes);
+    }
+}
+
+void Upscaler::nearest(const unsigned long long rows[32])
+{
+    for (int y = 0; y < 32; y++)
+    {
+        put(0, rows[y], 0u, 0u);
+        writeRow(y);
+    }
+}
+
+// Scale2x: A Corner Takes Its Neighbours' Color When They Agree With Each Other But Not With The Opposite Neighbours
+void Upscaler::scale2x(const unsigned long long rows[32])
+{
+    for (int y = 0; y < 32; y++)
+    {
+        Neighbourhood n(rows, y);
+        put(0, select(n.topLeft(), n.d, n.e), 0u, 0u);
+        put(1, select(n.topRight(), n.f, n.e), 0u, 0u);
+        writeRow(2 * y);
+        put(0, select(n.bottomLeft(), n.d, n.e), 0u, 0u);
+        put(1, select(n.bottomRight(), n.f, n.e), 0u, 0u);
+        writeRow(2 * y + 1);
+    }
+}
+
+// Scale3x: The Scale2x Corners, With The Edge Pixels Between Them Following A Corner Unless It Would Cut Into A Line
+void Upscaler::scale3x(const unsigned long long rows[32])
+{
+    for (int y = 0; y < 32; y++)
+    {
+        Neighbourhood n(rows, y);
+        unsigned long long topLeft = n.topLeft();
+        unsigned long long topRight = n.topRight();
+        unsigned long long bottomLeft = n.bottomLeft();
+        unsigned long long bottomRight = n.bottomRight();
+
+        put(0, select(topLeft, n.d, n.e), 0u, 0u);
+        put(1, select((topLeft & (n.e ^ n.c)) | (topRight & (n.e ^ n.a)), n.b, n.e), 0u, 0u);
+        put(2, select(topRight, n.f, n.e), 0u, 0u);
+        writeRow(3 * y);
+        put(0, select((topLeft & (n.e ^ n.g)) | (bottomLeft & (n.e ^ n.a)), n.d, n.e), 0u, 0u);
+        put(1, n.e, 0u, 0u);
+        put(2, select((topRight & (n.e ^ n.i)) | (bottomRight & (n.e ^ n.c)), n.f, n.e), 0u, 0u);
+        writeRow(3 * y + 1);
+        put(0, select(bottomLeft, n.d, n.e), 0u, 0u);
+        put(1, select((bottomLeft & (n.e ^ n.i)) | (bottomRight & (n.e ^ n.g)), n.h, n.e), 0u, 0u);
+        put(2, select(bottomRight, n.f, n.e), 0u, 0u);
+        writeRow(3 * y + 2);
+    }
+}
+
+/*
+HQ2x With Two Colors
+HQ2x compares each pixel with its eight neighbours and, case by case, blends each quarter of the enlarged pixel with the
+neighbours touching that corner. With only two colors every comparison is exact, and the cases reduce to two blends:
+where Scale2x would recolor a quarter (a diagonal edge runs through it) the quarter becomes half way between the colors,
+and where only the diagonal neighbour differs the quarter moves a quarter of the way towards it. Everywhere else the
+quarter keeps the pixel's color, so straight edges and one pixel lines stay sharp.
+*/
+void Upscaler::hq2x(const unsigned long long rows[32])
+{
+    for (int y = 0; y < 32; y++)
+    {
+        Neighbourhood n(rows, y);
+
+        // Each Quarter Goes Half Way Where Scale2x Finds A Diagonal Edge, And A Quarter Of The Way Where Only Its Diagonal Neighbour Differs
+        put(0, n.e, (n.a ^ n.e) & same(n.b, n.e) & same(n.d, n.e), n.topLeft() & (n.b ^ n.e));
+        put(1, n.e, (n.c ^ n.e) & same(n.b, n.e) & same(n.f, n.e), n.topRight() & (n.b ^ n.e));
+        writeRow(2 * y);
+        put(0, n.e, (n.g ^ n.e) & same(n.h, n.e) & same(n.d, n.e), n.bottomLeft() & (n.h ^ n.e));
+        put(1, n.e, (n.i ^ n.e) & same(n.h, n.e) & same(n.f, n.e), n.bottomRight() & (n.h ^ n.e));
+        writeRow(2 * y + 1);
+    }
+}
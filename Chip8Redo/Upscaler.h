@@ -0,0 +1,77 @@
+#ifndef UPSCALER_H
+#define UPSCALER_H
+//ensure header is only declared once
+#include <string> //For Filter Names
+#include <vector> //For The Output Buffer
+
+/*
+Enlarges A Packed 64 x 32 Display With A Pixel Art Filter
+The display only has two colors, so each filter's "are these neighbours the same color" tests become bitwise operations on
+whole rows: one 64 bit word holds a row, shifting it by one gives every pixel's left or right neighbour, and each rule is
+worked out for all 64 pixels of a row at once, and the bits are turned into bytes eight pixels to a word. The result is
+written as one byte per output pixel holding how lit it is in quarters (0 unlit - 4 lit, HQ2x uses the levels between
+to smooth edges), so the caller colors it with a five entry palette.
+The output buffer is sized by setFilter() and reused for every frame, scaling a frame never allocates.
+*/
+class Upscaler
+{
+public:
+    enum Filter
+    {
+        Nearest, // each pixel becomes a square block
+        Scale2x, // AdvMAME2x, rounds diagonal steps without adding colors
+        Scale3x, // AdvMAME3x
+        HQ2x     // HQ2x reduced to two colors, blends diagonal edges with the in between levels
+    };
+    static constexpr int LEVELS = 5; // the values an output pixel can hold
+    static constexpr int LIT = LEVELS - 1;
+
+    // Constructor
+    Upscaler();
+
+    // Choose The Filter And The Total Size Of An Output Pixel, The Filter's Pixels Are Repeated To Reach It
+    void setFilter(Filter filter, int scale);
+    Filter filter() const { return current; }
+    int factor() const { return filterFactor * repeat; } // output pixels per display pixel, across and down
+    int width() const { return 64 * factor(); }
+    int height() const { return 32 * factor(); }
+
+    // Scale One Display (A Word Per Row, Leftmost Pixel In The Highest Bit), Returns width() * height() Levels
+    const unsigned char *scale(const unsigned long long rows[32]);
+    const unsigned char *output() const { return pixels.data(); }
+
+    // Filter Names For Menus And Command Lines ("nearest", "scale2x", "scale3x", "hq2x")
+    static const char *name(Filter filter);
+    static bool filterNamed(const std::string &name, Filter &filter);
+
+private:
+    // Work Out The Levels Of One Phase (Column Of Each Filter Block) Of An Output Row
+    void put(int phase, unsigned long long lit, unsigned long long corner, unsigned long long half);
+    // Write The Phases Of An Output Row Into The Output, Each Filter Row Filling "repeat" Rows
+    void writeRow(int filterRow);
+    template <int Factor>
+    void interleave(unsigned char *out) const;
+    void repeatRow(int filterRow);
+
+    // Eight Bits Spread Into The Low Bit Of Eight Bytes
+    struct SpreadTable
+    {
+        unsigned long long spread[256];
+        SpreadTable();
+        unsigned long long operator[](unsigned int bits) const { return spread[bits]; }
+    };
+    static const SpreadTable byteSpread;
+
+    void nearest(const unsigned long long rows[32]);
+    void scale2x(const unsigned long long rows[32]);
+    void scale3x(const unsigned long long rows[32]);
+    void hq2x(const unsigned long long rows[32]);
+
+    Filter current = Nearest;
+    int filterFactor = 1; // output pixels the filter itself makes from one display pixel
+    int repeat = 1;       // how many times each filter pixel is repeated
+    std::vector<unsigned char> pixels;
+    unsigned char phaseLevels[3][64]; // the levels of the output row being worked out, one row per phase
+};
+
+#endif // UPSCALER_H
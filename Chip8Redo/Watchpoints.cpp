@@ -0,0 +1,88 @@
+#include "Watchpoints.h"
+
+//Constructor
+Watchpoints::Watchpoints()
+{
+    clear();
+}
+
+// Watch Reads, Writes Or Both Over "length" Bytes Starting At "address" (Wrapping At The End Of Memory)
+void Watchpoints::watch(unsigned short address, unsigned short length, Access access)
+{
+    for (unsigned int i = 0; i < length && i < 0x1000u; i++)
+    {
+        unsigned short watched = (address + i) & 0x0FFFu;
+        unsigned long long bit = 1ull << (watched & 63u);
+        if (access & Read)
+        {
+            readBits[watched >> 6u] |= bit;
+        }
+        if (access & Write)
+        {
+            writeBits[watched >> 6u] |= bit;
+        }
+    }
+    recount();
+}
+
+// Stop Watching "length" Bytes Starting At "address"
+void Watchpoints::unwatch(unsigned short address, unsigned short length)
+{
+    for (unsigned int i = 0; i < length && i < 0x1000u; i++)
+    {
+        unsigned short watched = (address + i) & 0x0FFFu;
+        unsigned long long bit = 1ull << (watched & 63u);
+        readBits[watched >> 6u] &= ~bit;
+        writeBits[watched >> 6u] &= ~bit;
+    }
+    recount();
+}
+
+// Stop Watching Everything And Forget Every Hit
+void Watchpoints::clear()
+{
+    for (int i = 0; i < 64; i++)
+    {
+        readBits[i] = 0u;
+        writeBits[i] = 0u;
+    }
+    watchedCount = 0;
+    clearEvents();
+}
+
+void Watchpoints::clearEvents()
+{
+    hits.clear();
+    totalHits = 0;
+}
+
+// Keep A Hit, Unless The Event List Is Already Full
+void Watchpoints::record(unsigned short address, unsigned char value, unsigned short pc, unsigned long long cycle, bool write)
+{
+    ++totalHits;
+    if (hits.size() < MAX_EVENTS)
+    {
+        WatchEvent event;
+        event.cycle = cycle;
+        event.pc = pc;
+        event.address = address & 0x0FFFu;
+        event.value = value;
+        event.write = write;
+        hits.push_back(event);
+    }
+}
+
+// Count The Watched Addresses Again After The Bitmaps Change
+void Watchpoints::recount()
+{
+    watchedCount = 0;
+    for (int i = 0; i < 64; i++)
+    {
+        unsigned long long word = readBits[i] | writeBits[i];
+        while (word != 0u)
+        {
+            word &= word - 1u;
+            ++watchedCount;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef WATCHPOINTS_H
+#define WATCHPOINTS_H
+//ensure header is only declared once
+#include <cstddef> //For size_t
+#include <vector>  //For The Hit Events
+
+// One Watched Memory Access, With The Cycle And The Address Of The Instruction That Made It
+struct WatchEvent
+{
+    unsigned long long cycle = 0; // how many instructions had run before the accessing instruction
+    unsigned short pc = 0;        // the address of the accessing instruction
+    unsigned short address = 0;   // the memory address that was accessed
+    unsigned char value = 0;      // the byte read, or the byte written
+    bool write = false;
+};
+
+/*
+Read And Write Watchpoints Over The 4096 Bytes Of Chip8 Memory
+Each kind of access has a bitmap with one bit per address. Only the instructions that touch memory through the index
+register (Fx33, Fx55, Fx65 and the sprite reads of Dxyn) consult it, and only when watchpoints are attached to the
+emulator, so a watched run costs one bit test per byte those instructions touch.
+*/
+class Watchpoints
+{
+public:
+    enum Access
+    {
+        Read = 1,
+        Write = 2,
+        ReadWrite = Read | Write
+    };
+
+    // Constructor
+    Watchpoints();
+
+    // Watching Addresses
+    void watch(unsigned short address, unsigned short length, Access access);
+    void unwatch(unsigned short address, unsigned short length);
+    void clear();
+    bool any() const { return watchedCount > 0; }
+    bool watchingReads(unsigned short address) const { return test(readBits, address); }
+    bool watchingWrites(unsigned short address) const { return test(writeBits, address); }
+
+    // Called By Chip8 For Every Byte The Memory Instructions Touch
+    void read(unsigned short address, unsigned char value, unsigned short pc, unsigned long long cycle)
+    {
+        if (test(readBits, address))
+        {
+            record(address, value, pc, cycle, false);
+        }
+    }
+    void write(unsigned short address, unsigned char value, unsigned short pc, unsigned long long cycle)
+    {
+        if (test(writeBits, address))
+        {
+            record(address, value, pc, cycle, true);
+        }
+    }
+
+    // The Recorded Hits (Only The First MAX_EVENTS Are Kept, hitCount() Keeps Counting Past That)
+    const std::vector<WatchEvent> &events() const { return hits; }
+    unsigned long long hitCount() const { return totalHits; }
+    void clearEvents();
+
+    static constexpr size_t MAX_EVENTS = 65536;
+
+private:
+    static bool test(const unsigned long long *bits, unsigned short address) { return (bits[(address & 0x0FFFu) >> 6u] >> (address & 63u)) & 1u; }
+    void record(unsigned short address, unsigned char value, unsigned short pc, unsigned long long cycle, bool write);
+    void recount();
+
+    unsigned long long readBits[64];  // 4096 bits, one per memory address
+    unsigned long long writeBits[64];
+    int watchedCount = 0; // how many addresses have either bit set
+    std::vector<WatchEvent> hits;
+    unsigned long long totalHits = 0;
+};
+
+#endif // WATCHPOINTS_H
@@ -64,6 +64,7 @@ BindKeys::BindKeys(QWidget *parent) :
     ui->keySequenceEdit_D->setKeySequence(bindKeys[13]);
     ui->keySequenceEdit_E->setKeySequence(bindKeys[14]);
     ui->keySequenceEdit_F->setKeySequence(bindKeys[15]);
+    rebuildKeyLookup();
 }
 
 BindKeys::~BindKeys()
@@ -112,6 +113,7 @@ void BindKeys::on_RestoreDefaults_clicked()
     ui->keySequenceEdit_D->setKeySequence(bindKeys[13]);
     ui->keySequenceEdit_E->setKeySequence(bindKeys[14]);
     ui->keySequenceEdit_F->setKeySequence(bindKeys[15]);
+    rebuildKeyLookup();
 }
 //This and the following 15 functions check to make sure the key selected in a keySequenceEdit is not the same as any of the keys in the other keySequenceEdits. If it is, an error message
 //will appear and the key will be returned to what it was previously. if no error occurs, the appropriate bindKeys variable will be updated to the selected key.
@@ -127,6 +129,7 @@ void BindKeys::on_keySequenceEdit_1_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[0] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {//If invalid_argument error occurs, restores the keySequenceEdit to what it was previously and displays an error message
@@ -149,6 +152,7 @@ void BindKeys::on_keySequenceEdit_2_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[1] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
 
@@ -173,6 +177,7 @@ void BindKeys::on_keySequenceEdit_3_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[2] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -196,6 +201,7 @@ void BindKeys::on_keySequenceEdit_4_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[3] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -219,6 +225,7 @@ void BindKeys::on_keySequenceEdit_5_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[4] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -242,6 +249,7 @@ void BindKeys::on_keySequenceEdit_6_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[5] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -265,6 +273,7 @@ void BindKeys::on_keySequenceEdit_7_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[6] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -288,6 +297,7 @@ void BindKeys::on_keySequenceEdit_8_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[7] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -311,6 +321,7 @@ void BindKeys::on_keySequenceEdit_9_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[8] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -335,6 +346,7 @@ void BindKeys::on_keySequenceEdit_0_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[9] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -358,6 +370,7 @@ void BindKeys::on_keySequenceEdit_A_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[10] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -381,6 +394,7 @@ void BindKeys::on_keySequenceEdit_B_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[11] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -404,6 +418,7 @@ void BindKeys::on_keySequenceEdit_C_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[12] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -427,6 +442,7 @@ void BindKeys::on_keySequenceEdit_D_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[13] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -450,6 +466,7 @@ void BindKeys::on_keySequenceEdit_E_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[14] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -473,6 +490,7 @@ void BindKeys::on_keySequenceEdit_F_editingFinished()
         QKeySequence keySequence = QKeySequence(keyString);
         int mainKey = keySequence[0];
         bindKeys[15] = static_cast<Qt::Key>(mainKey);
+        rebuildKeyLookup();
     }
 
     catch (std::invalid_argument& e) {
@@ -482,25 +500,11 @@ void BindKeys::on_keySequenceEdit_F_editingFinished()
         msgBox.exec();
     }
 }
-//This funcion handles the signal for a key press and sets the corresponding key value inside the emulator
-//to a vlaue of 1
-void BindKeys::handleKeyPress(Qt::Key key, Chip8& EmulatorRef)
+//This rebuilds the table that maps each Qt key straight to its keypad key, so a key event needs one lookup instead of a scan
+void BindKeys::rebuildKeyLookup()
 {
+    keyLookup.clear();
     for (int index = 0; index < 16; index++){
-        if (key == bindKeys[index]){
-            EmulatorRef.keypad[index] = 1;
-            qDebug() << "Pressed Key: " << key << " Value: " << index;
-        }
-    }
-}
-//This funcion handles the signal for a key release and sets the corresponding key value inside the emulator
-//to a vlaue of 0
-void BindKeys::handleKeyRelease(Qt::Key key, Chip8& EmulatorRef)
-{
-    for (int index = 0; index < 16; index++){
-        if (key == bindKeys[index]){
-           EmulatorRef.keypad[index] = 0;
-           qDebug() << "Released Key: " << key << " Value: " << index;
-        }
+        keyLookup.insert(bindKeys[index], index);
     }
 }
@@ -3,6 +3,7 @@
 
 #include <QDialog>
 #include <QKeyEvent>
+#include <QHash>
 #include "Chip8.h"
 
 
@@ -17,9 +18,8 @@ class BindKeys : public QDialog
 public:
     explicit BindKeys(QWidget *parent = nullptr);
     ~BindKeys();
-public slots:
-    void handleKeyPress(Qt::Key key, Chip8& EmulatorRef);
-    void handleKeyRelease(Qt::Key key, Chip8& EmulatorRef);
+    //Returns the keypad key (0 - F) bound to a Qt key, or -1 if the key is not bound
+    int keypadIndex(int key) const { return keyLookup.value(key, -1); }
 private slots:
     void on_Close_clicked();
 
@@ -60,6 +60,8 @@ private slots:
 private:
     Ui::BindKeys *ui;
     Qt::Key tempKey;
+    QHash<int, int> keyLookup;//Qt key to keypad key, rebuilt whenever a binding changes
+    void rebuildKeyLookup();
 
 };
 
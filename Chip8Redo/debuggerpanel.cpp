@@ -0,0 +1,266 @@
+#include "debuggerpanel.h"
+#include <QFontDatabase>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QPushButton>
+#include <QRegularExpression>
+#include <QVBoxLayout>
+#include <algorithm>
+
+DebuggerPanel::DebuggerPanel(Debugger &debugger, const Chip8 &emulator, QWidget *parent)
+    : QDockWidget("Debugger", parent), debuggerRef(debugger), emulatorRef(emulator)
+{
+    setObjectName("debuggerPanel");
+    QFont fixedFont = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    QWidget *contents = new QWidget(this);
+    QVBoxLayout *layout = new QVBoxLayout(contents);
+
+    //Continue, Break and the three kinds of step
+    QHBoxLayout *buttons = new QHBoxLayout();
+    QPushButton *continueButton = new QPushButton("Continue", contents);
+    QPushButton *breakButton = new QPushButton("Break", contents);
+    QPushButton *stepIntoButton = new QPushButton("Step Into", contents);
+    QPushButton *stepOverButton = new QPushButton("Step Over", contents);
+    QPushButton *stepOutButton = new QPushButton("Step Out", contents);
+    buttons->addWidget(continueButton);
+    buttons->addWidget(breakButton);
+    buttons->addWidget(stepIntoButton);
+    buttons->addWidget(stepOverButton);
+    buttons->addWidget(stepOutButton);
+    layout->addLayout(buttons);
+    connect(continueButton, &QPushButton::clicked, this, &DebuggerPanel::continueRequested);
+    connect(breakButton, &QPushButton::clicked, this, &DebuggerPanel::breakRequested);
+    connect(stepIntoButton, &QPushButton::clicked, this, [this]() { emit stepRequested(StepInto); });
+    connect(stepOverButton, &QPushButton::clicked, this, [this]() { emit stepRequested(StepOver); });
+    connect(stepOutButton, &QPushButton::clicked, this, [this]() { emit stepRequested(StepOut); });
+
+    //Recording, and going backwards through what was recorded
+    QHBoxLayout *reverseButtons = new QHBoxLayout();
+    QPushButton *recordButton = new QPushButton("Record", contents);
+    recordButton->setCheckable(true);
+    QPushButton *stepBackButton = new QPushButton("Step Back", contents);
+    QPushButton *reverseContinueButton = new QPushButton("Reverse Continue", contents);
+    reverseButtons->addWidget(recordButton);
+    reverseButtons->addWidget(stepBackButton);
+    reverseButtons->addWidget(reverseContinueButton);
+    layout->addLayout(reverseButtons);
+    connect(recordButton, &QPushButton::toggled, this, &DebuggerPanel::setRecording);
+    connect(stepBackButton, &QPushButton::clicked, this, [this]() { emit stepRequested(StepBack); });
+    connect(reverseContinueButton, &QPushButton::clicked, this, [this]() { emit stepRequested(ReverseContinue); });
+
+    //Registers on the left, the stack on the right
+    QHBoxLayout *state = new QHBoxLayout();
+    registersLabel = new QLabel(contents);
+    registersLabel->setFont(fixedFont);
+    registersLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    stackList = new QListWidget(contents);
+    stackList->setFont(fixedFont);
+    stackList->setMaximumWidth(120);
+    state->addWidget(registersLabel);
+    state->addWidget(stackList);
+    layout->addLayout(state);
+
+    //The disassembly, double click a line to toggle a breakpoint on it
+    disassemblyList = new QListWidget(contents);
+    disassemblyList->setFont(fixedFont);
+    layout->addWidget(disassemblyList, 1);
+    connect(disassemblyList, &QListWidget::itemDoubleClicked, this, &DebuggerPanel::toggleBreakpoint);
+
+    conditionEdit = new QLineEdit(contents);
+    conditionEdit->setPlaceholderText("Conditional breakpoint, e.g. 2A0 V3 == 5");
+    layout->addWidget(conditionEdit);
+    connect(conditionEdit, &QLineEdit::returnPressed, this, &DebuggerPanel::addConditionalBreakpoint);
+
+    //Memory watchpoints and the accesses that hit them
+    watchEdit = new QLineEdit(contents);
+    watchEdit->setPlaceholderText("Watchpoint, e.g. 300 10 w (empty clears)");
+    layout->addWidget(watchEdit);
+    connect(watchEdit, &QLineEdit::returnPressed, this, &DebuggerPanel::addWatchpoint);
+    watchList = new QListWidget(contents);
+    watchList->setFont(fixedFont);
+    watchList->setMaximumHeight(120);
+    layout->addWidget(watchList);
+
+    //Searching the recording, double click an answer to go back to it
+    traceLabel = new QLabel(contents);
+    layout->addWidget(traceLabel);
+    queryEdit = new QLineEdit(contents);
+    queryEdit->setPlaceholderText("Search the recording, e.g. V3, I 2A0, PC 2A0, M 300 or DRAW 10 5");
+    layout->addWidget(queryEdit);
+    connect(queryEdit, &QLineEdit::returnPressed, this, &DebuggerPanel::runQuery);
+    queryList = new QListWidget(contents);
+    queryList->setFont(fixedFont);
+    queryList->setMaximumHeight(120);
+    layout->addWidget(queryList);
+    connect(queryList, &QListWidget::itemDoubleClicked, this, [this](QListWidgetItem *item) {
+        if (item->data(Qt::UserRole).isValid()) {
+            emit travelRequested(item->data(Qt::UserRole).toULongLong());
+        }
+    });
+
+    setWidget(contents);
+    refresh();
+}
+
+//Redraw the registers, stack and disassembly
+void DebuggerPanel::refresh()
+{
+    QString registers;
+    for (int i = 0; i < 16; i++) {
+        registers += QString("V%1 %2%3").arg(i, 1, 16).arg(emulatorRef.registers[i], 2, 16, QChar('0')).arg((i % 4 == 3) ? "\n" : "   ");
+    }
+    registers += QString("\nI  %1   PC %2   SP %3\nDT %4   ST %5")
+                     .arg(emulatorRef.index, 3, 16, QChar('0'))
+                     .arg(emulatorRef.pc, 3, 16, QChar('0'))
+                     .arg(emulatorRef.sp)
+                     .arg(emulatorRef.delayTimer)
+                     .arg(emulatorRef.soundTimer);
+    registersLabel->setText(registers.toUpper());
+
+    stackList->clear();
+    for (int level = static_cast<int>(emulatorRef.sp) - 1; level >= 0 && level < 16; level--) {
+        stackList->addItem(QString("%1: %2").arg(level).arg(emulatorRef.stack[level], 3, 16, QChar('0')).toUpper());
+    }
+
+    //Show a window of instructions around the program counter, marking breakpoints with * and the program counter with >
+    disassemblyList->clear();
+    int start = std::max(0, static_cast<int>(emulatorRef.pc) - DISASSEMBLY_BEFORE * 2);
+    int end = std::min(0x0FFE, static_cast<int>(emulatorRef.pc) + DISASSEMBLY_AFTER * 2);
+    for (int address = start; address <= end; address += 2) {
+        unsigned short opcode = (emulatorRef.memory[address] << 8u) | emulatorRef.memory[address + 1];
+        QString marker = debuggerRef.hasBreakpoint(address) ? (debuggerRef.hasCondition(address) ? "?" : "*") : " ";
+        QString line = QString("%1%2 %3  %4  %5")
+                           .arg(marker)
+                           .arg(address == emulatorRef.pc ? ">" : " ")
+                           .arg(address, 3, 16, QChar('0'))
+                           .arg(opcode, 4, 16, QChar('0'))
+                           .arg(QString::fromStdString(disassemble(opcode)));
+        QListWidgetItem *item = new QListWidgetItem(line.toUpper(), disassemblyList);
+        item->setData(Qt::UserRole, address);
+        if (address == emulatorRef.pc) {
+            item->setBackground(Qt::yellow);
+            disassemblyList->setCurrentItem(item);
+        }
+    }
+
+    //List the most recent watchpoint hits, the newest first
+    watchList->clear();
+    const std::vector<WatchEvent> &events = debuggerRef.watchpoints.events();
+    for (int i = static_cast<int>(events.size()) - 1; i >= 0 && i >= static_cast<int>(events.size()) - WATCH_EVENTS_SHOWN; i--) {
+        const WatchEvent &event = events[i];
+        watchList->addItem(QString("cycle %1  pc %2  %3 %4 = %5")
+                               .arg(event.cycle)
+                               .arg(event.pc, 3, 16, QChar('0'))
+                               .arg(event.write ? "write" : "read ")
+                               .arg(event.address, 3, 16, QChar('0'))
+                               .arg(event.value, 2, 16, QChar('0')));
+    }
+
+    const TraceDatabase &trace = debuggerRef.trace;
+    if (trace.empty()) {
+        traceLabel->setText(debuggerRef.isRecording() ? "Recording" : "Nothing recorded");
+    }
+    else {
+        traceLabel->setText(QString("%1cycles %2 - %3 (%4 MB), now at %5")
+                                .arg(debuggerRef.isRecording() ? "Recording " : "Recorded ")
+                                .arg(trace.firstCycle())
+                                .arg(trace.endCycle())
+                                .arg(trace.memoryUsage() >> 20u)
+                                .arg(emulatorRef.cycle));
+    }
+}
+
+//Add a breakpoint on the double clicked line, or remove the one already there
+void DebuggerPanel::toggleBreakpoint(QListWidgetItem *item)
+{
+    emit breakRequested();//the emulation thread reads breakpoints and watchpoints, so only change them while it is stopped
+    unsigned short address = static_cast<unsigned short>(item->data(Qt::UserRole).toInt());
+    if (debuggerRef.hasBreakpoint(address)) {
+        debuggerRef.removeBreakpoint(address);
+    }
+    else {
+        debuggerRef.addBreakpoint(address);
+    }
+    refresh();
+}
+
+//Parse "address register comparison value" and add it as a conditional breakpoint
+void DebuggerPanel::addConditionalBreakpoint()
+{
+    emit breakRequested();//the emulation thread reads breakpoints and watchpoints, so only change them while it is stopped
+    static const QRegularExpression pattern("^\\s*([0-9A-Fa-f]{1,3})\\s+(V[0-9A-Fa-f]|I)\\s*(==|!=|<|>)\\s*([0-9A-Fa-f]{1,3})\\s*$", QRegularExpression::CaseInsensitiveOption);
+    QRegularExpressionMatch match = pattern.match(conditionEdit->text());
+    if (!match.hasMatch()) {
+        conditionEdit->selectAll();
+        return;
+    }
+
+    Debugger::Condition condition;
+    QString target = match.captured(2).toUpper();
+    condition.target = (target == "I") ? Debugger::INDEX_TARGET : target.mid(1).toInt(nullptr, 16);
+    QString comparison = match.captured(3);
+    condition.comparison = (comparison == "==") ? Debugger::Condition::Equal
+                         : (comparison == "!=") ? Debugger::Condition::NotEqual
+                         : (comparison == "<")  ? Debugger::Condition::Less
+                                                : Debugger::Condition::Greater;
+    condition.value = static_cast<unsigned short>(match.captured(4).toUInt(nullptr, 16));
+    debuggerRef.addBreakpoint(static_cast<unsigned short>(match.captured(1).toUInt(nullptr, 16)), condition);
+
+    conditionEdit->clear();
+    refresh();
+}
+
+//Parse "address length access" and watch that memory, an empty line removes every watchpoint
+void DebuggerPanel::addWatchpoint()
+{
+    emit breakRequested();//the emulation thread reads breakpoints and watchpoints, so only change them while it is stopped
+    if (watchEdit->text().trimmed().isEmpty()) {
+        debuggerRef.watchpoints.clear();
+        refresh();
+        return;
+    }
+
+    static const QRegularExpression pattern("^\\s*([0-9A-Fa-f]{1,3})\\s+([0-9A-Fa-f]{1,4})\\s+(rw|r|w)\\s*$", QRegularExpression::CaseInsensitiveOption);
+    QRegularExpressionMatch match = pattern.match(watchEdit->text());
+    if (!match.hasMatch()) {
+        watchEdit->selectAll();
+        return;
+    }
+
+    QString access = match.captured(3).toLower();
+    debuggerRef.watchpoints.watch(static_cast<unsigned short>(match.captured(1).toUInt(nullptr, 16)),
+                                  static_cast<unsigned short>(match.captured(2).toUInt(nullptr, 16)),
+                                  (access == "r") ? Watchpoints::Read : (access == "w") ? Watchpoints::Write : Watchpoints::ReadWrite);
+
+    watchEdit->clear();
+    refresh();
+}
+
+//Start or stop recording, what was recorded stays searchable until a new recording starts
+void DebuggerPanel::setRecording(bool record)
+{
+    emit breakRequested();//the emulation thread records through the debugger, so only change it while it is stopped
+    debuggerRef.setRecording(record);
+    refresh();
+}
+
+//Answer the question typed in, looking back from where the emulator is now
+void DebuggerPanel::runQuery()
+{
+    emit breakRequested();//the emulation thread adds to the recording, so only read it while it is stopped
+    std::string error;
+    std::vector<TraceDatabase::Hit> hits = debuggerRef.trace.query(queryEdit->text().toStdString(), emulatorRef.cycle, QUERY_RESULTS_SHOWN, error);
+    if (!error.empty()) {
+        queryEdit->selectAll();
+        return;
+    }
+
+    queryList->clear();
+    for (const TraceDatabase::Hit &hit : hits) {
+        QListWidgetItem *item = new QListWidgetItem(QString::fromStdString(hit.text), queryList);
+        item->setData(Qt::UserRole, hit.cycle);
+    }
+    if (hits.empty()) {
+        queryList->addItem("Nothing recorded before now");
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef DEBUGGERPANEL_H
+#define DEBUGGERPANEL_H
+
+#include <QDockWidget>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListWidget>
+#include "Chip8.h"
+#include "Debugger.h"
+
+/*
+A dockable panel showing the emulator's registers, stack, timers and the disassembly around the program counter
+Double clicking a line of the disassembly toggles a breakpoint there, and the line edit adds conditional breakpoints
+written as "address register comparison value" in hex, for example "2A0 V3 == 5" or "2A0 I > 300"
+Memory watchpoints are written as "address length access" in hex, for example "300 10 w" (access is r, w or rw)
+While Record is down every instruction is recorded, so Step Back and Reverse Continue can go backwards through the program, and the
+recording can be searched (see TraceDatabase::query(), for example "V3", "I 2A0", "PC 2A0", "M 300" or "DRAW 10 5"), double
+clicking a result goes back to it
+*/
+class DebuggerPanel : public QDockWidget
+{
+    Q_OBJECT
+
+public:
+    //How far a step should run
+    enum StepKind
+    {
+        StepInto,
+        StepOver,
+        StepOut,
+        StepBack,
+        ReverseContinue
+    };
+
+    DebuggerPanel(Debugger &debugger, const Chip8 &emulator, QWidget *parent = nullptr);
+
+public slots:
+    //Redraw every view from the current emulator state
+    void refresh();
+
+signals:
+    void continueRequested();
+    void breakRequested();
+    void stepRequested(DebuggerPanel::StepKind kind);
+    void travelRequested(unsigned long long cycle);
+
+private slots:
+    void toggleBreakpoint(QListWidgetItem *item);
+    void addConditionalBreakpoint();
+    void addWatchpoint();
+    void setRecording(bool record);
+    void runQuery();
+
+private:
+    Debugger &debuggerRef;
+    const Chip8 &emulatorRef;
+    QLabel *registersLabel;//V0 - VF, I, PC, SP and the timers
+    QListWidget *stackList;//Every return address on the stack, the newest first
+    QListWidget *disassemblyList;//The instructions around the program counter
+    QLineEdit *conditionEdit;//Where conditional breakpoints are typed
+    QLineEdit *watchEdit;//Where memory watchpoints are typed
+    QListWidget *watchList;//The most recent watchpoint hits
+    QLabel *traceLabel;//How much has been recorded
+    QLineEdit *queryEdit;//Where questions about the recording are typed
+    QListWidget *queryList;//The answers, the latest first
+    static constexpr int WATCH_EVENTS_SHOWN = 64;//How many watchpoint hits are listed
+    static constexpr int QUERY_RESULTS_SHOWN = 256;//How many answers to a query are listed
+    static constexpr int DISASSEMBLY_BEFORE = 8;//How many instructions are shown before the program counter
+    static constexpr int DISASSEMBLY_AFTER = 24;//How many instructions are shown after it
+};
+
+#endif // DEBUGGERPANEL_H
@@ -0,0 +1,244 @@
+#include "emulationserver.h"
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+namespace
+{
+    //Append little endian numbers to a reply
+    void appendU8(QByteArray &buffer, quint8 value)
+    {
+        buffer.append(static_cast<char>(value));
+    }
+    void appendU16(QByteArray &buffer, quint16 value)
+    {
+        char bytes[2];
+        qToLittleEndian(value, bytes);
+        buffer.append(bytes, 2);
+    }
+    void appendU32(QByteArray &buffer, quint32 value)
+    {
+        char bytes[4];
+        qToLittleEndian(value, bytes);
+        buffer.append(bytes, 4);
+    }
+
+    //Append one result (status and data) to a reply
+    void appendResult(QByteArray &reply, quint8 status, const QByteArray &data = QByteArray())
+    {
+        appendU8(reply, status);
+        appendU32(reply, static_cast<quint32>(data.size()));
+        reply.append(data);
+    }
+}
+
+EmulationServer::EmulationServer(int maxInstances, QObject *parent)
+    : QObject(parent), server(new QLocalServer(this)), maxInstances(maxInstances), instances(maxInstances, false)
+{
+    connect(server, &QLocalServer::newConnection, this, &EmulationServer::acceptConnection);
+}
+
+EmulationServer::~EmulationServer()
+{
+    frames.detach();
+}
+
+//Start listening on the given name and create the shared display memory
+bool EmulationServer::listen(const QString &name)
+{
+    frames.setKey(name + "-frames");
+    if (!frames.create(maxInstances * FRAME_BYTES)) {
+        //Reuse a segment left behind by a server that did not exit cleanly, as long as it is large enough
+        if (frames.error() != QSharedMemory::AlreadyExists || !frames.attach() || frames.size() < maxInstances * FRAME_BYTES) {
+            error = frames.errorString();
+            return false;
+        }
+    }
+    std::memset(frames.data(), 0, frames.size());
+
+    QLocalServer::removeServer(name);//Clear a socket left behind by a server that did not exit cleanly
+    if (!server->listen(name)) {
+        error = server->errorString();
+        return false;
+    }
+    return true;
+}
+
+void EmulationServer::acceptConnection()
+{
+    while (QLocalSocket *socket = server->nextPendingConnection()) {
+        pending.insert(socket, QByteArray());
+        connect(socket, &QLocalSocket::readyRead, this, &EmulationServer::readRequests);
+        connect(socket, &QLocalSocket::disconnected, this, &EmulationServer::dropConnection);
+    }
+}
+
+void EmulationServer::dropConnection()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    pending.remove(socket);
+    socket->deleteLater();
+}
+
+//Run every whole request that has arrived on the socket, answering each batch with one reply
+void EmulationServer::readRequests()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    QByteArray &buffer = pending[socket];
+    buffer.append(socket->readAll());
+
+    while (buffer.size() >= 4) {
+        quint32 length = qFromLittleEndian<quint32>(buffer.constData());
+        if (length > MAX_REQUEST_BYTES) {
+            //Nothing sensible is that long, and its end could never be found again, so give up on the client
+            pending.remove(socket);
+            socket->abort();
+            return;
+        }
+        if (static_cast<quint64>(length) > static_cast<quint64>(buffer.size()) - 4) {
+            break;//Wait for the rest of the request
+        }
+
+        const char *data = buffer.constData() + 4;
+        const char *end = data + length;
+        QByteArray reply;
+        quint16 results = 0;
+        quint64 cycleBudget = MAX_REQUEST_CYCLES;
+
+        quint16 count = 0;
+        if (length >= 2) {
+            count = qFromLittleEndian<quint16>(data);
+            data += 2;
+        }
+        for (quint16 i = 0; i < count; i++) {
+            //Each command header is 9 bytes: operation, instance and argument length
+            if (end - data < 9) {
+                appendResult(reply, BAD_REQUEST);
+                results++;
+                break;
+            }
+            quint8 operation = static_cast<quint8>(data[0]);
+            quint32 instance = qFromLittleEndian<quint32>(data + 1);
+            quint32 argumentLength = qFromLittleEndian<quint32>(data + 5);
+            data += 9;
+            if (static_cast<quint32>(end - data) < argumentLength) {
+                appendResult(reply, BAD_REQUEST);
+                results++;
+                break;
+            }
+            execute(operation, instance, QByteArray::fromRawData(data, static_cast<int>(argumentLength)), reply, cycleBudget);
+            results++;
+            data += argumentLength;
+        }
+
+        QByteArray header;
+        appendU32(header, static_cast<quint32>(reply.size() + 2));
+        appendU16(header, results);
+        socket->write(header + reply);
+        buffer.remove(0, 4 + static_cast<int>(length));
+    }
+}
+
+//Run one command from a batch and append its result to the reply
+void EmulationServer::execute(quint8 operation, quint32 instance, const QByteArray &arguments, QByteArray &reply, quint64 &cycleBudget)
+{
+    if (operation == CREATE) {
+        //Without a seed the instance is seeded from the clock, as a new Chip8 is
+        quint32 seed = (arguments.size() >= 4) ? qFromLittleEndian<quint32>(arguments.constData()) : static_cast<quint32>(time(NULL));
+        size_t slot = instances.create(seed);
+        if (slot == Chip8Pool::NO_INSTANCE) {
+            appendResult(reply, NO_FREE_INSTANCE);
+            return;
+        }
+        QByteArray data;
+        appendU32(data, static_cast<quint32>(slot));
+        appendResult(reply, OK, data);
+        return;
+    }
+
+    if (!instances.exists(instance)) {
+        appendResult(reply, UNKNOWN_INSTANCE);
+        return;
+    }
+    if (operation == DESTROY) {
+        instances.destroy(instance);
+        appendResult(reply, OK);
+        return;
+    }
+    if (operation == LOAD_ROM) {
+        try {
+            instances.loadProgram(instance, reinterpret_cast<const unsigned char *>(arguments.constData()), static_cast<size_t>(arguments.size()));
+            appendResult(reply, OK);
+        } catch (std::exception &exception) {
+            appendResult(reply, FAULT, QByteArray(exception.what()));
+        }
+        return;
+    }
+    Chip8 &emulator = instances.emulator(instance);
+
+    switch (operation) {
+    case STEP: {
+        if (arguments.size() < 4) {
+            appendResult(reply, BAD_REQUEST);
+            break;
+        }
+        //Long runs are cut short (the reply says how many ran) so every other client still gets answered promptly
+        quint64 cycles = std::min<quint64>(std::min(qFromLittleEndian<quint32>(arguments.constData()), MAX_STEP_CYCLES), cycleBudget);
+        QByteArray data;
+        //A fault stops the run and reports exactly how many instructions ran before it
+        Chip8::RunResult result = emulator.runInstructions(cycles);
+        cycleBudget -= std::min<quint64>(result.executed, cycleBudget);
+        appendU32(data, static_cast<quint32>(result.executed));
+        if (result.ok()) {
+            appendResult(reply, OK, data);
+        } else {
+            data.append(QByteArray::fromStdString(Chip8::faultMessage(result.fault, result.opcode)));
+            appendResult(reply, FAULT, data);
+        }
+        break;
+    }
+
+    case SET_KEYPAD:
+        if (arguments.size() < 2) {
+            appendResult(reply, BAD_REQUEST);
+            break;
+        }
+        emulator.setKeys(qFromLittleEndian<quint16>(arguments.constData()));
+        appendResult(reply, OK);
+        break;
+
+    case GET_STATE: {
+        QByteArray data;
+        data.append(reinterpret_cast<const char *>(emulator.registers), 16);
+        appendU16(data, emulator.index);
+        appendU16(data, emulator.pc);
+        appendU8(data, emulator.sp);
+        appendU8(data, emulator.delayTimer);
+        appendU8(data, emulator.soundTimer);
+        for (int level = 0; level < 16; level++) {
+            appendU16(data, emulator.stack[level]);
+        }
+        appendResult(reply, OK, data);
+        break;
+    }
+
+    case GET_FRAME: {
+        //Pack the display straight into this instance's slot of the shared memory
+        quint32 offset = instance * FRAME_BYTES;
+        uchar *slot = static_cast<uchar *>(frames.data()) + offset;
+        frames.lock();
+        for (int y = 0; y < 32; y++) {
+            qToLittleEndian(static_cast<quint64>(emulator.video[y]), slot + y * 8);
+        }
+        frames.unlock();
+        QByteArray data;
+        appendU32(data, offset);
+        appendResult(reply, OK, data);
+        break;
+    }
+
+    default:
+        appendResult(reply, BAD_REQUEST);
+    }
+}
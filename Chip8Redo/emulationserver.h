@@ -0,0 +1,92 @@
+#ifndef EMULATIONSERVER_H
+#define EMULATIONSERVER_H
+
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QSharedMemory>
+#include <QHash>
+#include <memory>
+#include <vector>
+#include "Chip8Pool.h"
+
+/*
+Hosts a pool of headless emulators for other processes, over a local socket (a Unix domain socket on Linux and macOS, a named pipe on Windows)
+
+Every number is little endian. A request is one message holding a batch of commands:
+    u32 payload length, u16 command count, then per command: u8 operation, u32 instance, u32 argument length, arguments
+The reply holds one result per command, in the same order:
+    u32 payload length, u16 result count, then per result: u8 status, u32 data length, data
+
+Operations (arguments -> data):
+    CREATE      u32 seed            -> u32 instance
+    DESTROY     none                -> none
+    LOAD_ROM    ROM bytes           -> none
+    STEP        u32 cycles          -> u32 cycles executed (less than asked if the program faulted or a limit below was reached)
+    SET_KEYPAD  u16 key mask        -> none
+    GET_STATE   none                -> u8 registers[16], u16 index, u16 pc, u8 sp, u8 delay timer, u8 sound timer, u16 stack[16]
+    GET_FRAME   none                -> u32 offset of the display in shared memory
+
+A request longer than MAX_REQUEST_BYTES drops the connection. Requests are run on the server's one thread, so to keep one client
+from stalling the rest a STEP runs at most MAX_STEP_CYCLES instructions and a whole request at most MAX_REQUEST_CYCLES, a client
+wanting more sends STEP again.
+
+Instances live in a Chip8Pool, so they share the pages of the ROMs they load and each one only costs the memory it changes.
+Displays are not sent over the socket. The shared memory segment named "<server name>-frames" holds 256 bytes per instance
+(32 rows of a u64, the leftmost pixel in the highest bit), GET_FRAME writes the instance's display there and clients read it in place.
+*/
+class EmulationServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Operation : quint8
+    {
+        CREATE = 1,
+        DESTROY = 2,
+        LOAD_ROM = 3,
+        STEP = 4,
+        SET_KEYPAD = 5,
+        GET_STATE = 6,
+        GET_FRAME = 7
+    };
+
+    enum Status : quint8
+    {
+        OK = 0,
+        UNKNOWN_INSTANCE = 1,
+        BAD_REQUEST = 2,
+        FAULT = 3,
+        NO_FREE_INSTANCE = 4
+    };
+
+    static constexpr int FRAME_BYTES = 256;
+    static constexpr quint32 MAX_REQUEST_BYTES = 16 * 1024 * 1024;//room for a ROM for every one of thousands of instances
+    static constexpr quint32 MAX_STEP_CYCLES = 1000000;
+    static constexpr quint64 MAX_REQUEST_CYCLES = 10000000;//a few tens of milliseconds
+
+    EmulationServer(int maxInstances, QObject *parent = nullptr);
+    ~EmulationServer();
+
+    //Start listening on the given name and create the shared display memory, returns false and sets the error text on failure
+    bool listen(const QString &name);
+    QString errorString() const { return error; }
+
+private slots:
+    void acceptConnection();
+    void readRequests();
+    void dropConnection();
+
+private:
+    //Run one command from a batch and append its result to the reply, STEP takes its instructions from "cycleBudget"
+    void execute(quint8 operation, quint32 instance, const QByteArray &arguments, QByteArray &reply, quint64 &cycleBudget);
+
+    QLocalServer *server;
+    QSharedMemory frames;
+    int maxInstances;
+    Chip8Pool instances;
+    QHash<QLocalSocket *, QByteArray> pending;//Bytes received from each client that do not yet form a whole request
+    QString error;
+};
+
+#endif // EMULATIONSERVER_H
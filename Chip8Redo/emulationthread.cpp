@@ -0,0 +1,201 @@
+#include "emulationthread.h"
+#include <algorithm>
+
+EmulationThread::EmulationThread(Chip8 &emulator, Debugger &debugger, FrameCapture &capture, QObject *parent)
+    : QObject(parent), emulatorRef(emulator), debuggerRef(debugger), captureRef(capture)
+{
+    thread = std::thread(&EmulationThread::run, this);
+}
+
+EmulationThread::~EmulationThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    changed.notify_all();
+    thread.join();
+}
+
+void EmulationThread::resume()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        runRequested = true;
+    }
+    changed.notify_all();
+}
+
+//Ask the thread to stop, then wait until it has finished the instructions it was running
+void EmulationThread::pause()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    runRequested = false;
+    changed.notify_all();
+    changed.wait(lock, [this]() { return parked; });
+}
+
+void EmulationThread::setCycleSpeed(int millisecondsPerInstruction)
+{
+    cycleSpeed = std::max(0, millisecondsPerInstruction);
+    wake();
+}
+
+void EmulationThread::wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        woken = true;
+    }
+    changed.notify_all();
+}
+
+void EmulationThread::pack(const Chip8 &emulator, DisplayFrame &frame)
+{
+    for (int y = 0; y < 32; y++) {
+        frame.rows[y] = emulator.video[y];
+    }
+}
+
+//Park while paused, otherwise keep running slices of instructions until told to pause or quit
+void EmulationThread::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!quit) {
+        if (!runRequested) {
+            parked = true;
+            changed.notify_all();
+            changed.wait(lock, [this]() { return runRequested || quit; });
+            //Start timing again from now, so a long pause is not caught up on
+            paceStart = std::chrono::steady_clock::now();
+            instructionsSincePaceStart = 0;
+            continue;
+        }
+
+        parked = false;
+        lock.unlock();
+        bool keepRunning = runSlice();
+        lock.lock();
+        if (!keepRunning) {
+            runRequested = false;
+        }
+    }
+    parked = true;
+    changed.notify_all();
+}
+
+//Execute the instructions that are due at the chosen speed, publish the display and feed the capture
+bool EmulationThread::runSlice()
+{
+    auto now = std::chrono::steady_clock::now();
+    int speed = cycleSpeed;
+    if (woken.exchange(false)) {
+        //A key event or speed change restarts the timing so the emulator neither races nor stalls to catch up
+        paceStart = now;
+        instructionsSincePaceStart = 0;
+    }
+
+    //Work out how many instructions should have run by now
+    unsigned long long due = SLICE_INSTRUCTIONS;
+    if (speed > 0) {
+        unsigned long long elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - paceStart).count();
+        unsigned long long target = elapsed / speed + 1;
+        due = (target > instructionsSincePaceStart) ? std::min<unsigned long long>(target - instructionsSincePaceStart, SLICE_INSTRUCTIONS) : 0;
+    }
+
+    std::chrono::steady_clock::duration sleep(0);
+    bool idle = false;
+    Chip8::RunResult result;
+    if (debuggerRef.active()) {
+        //Go through the debugger only while breakpoints or watchpoints are set
+        Debugger::StopReason stop = (due > 0) ? debuggerRef.run(emulatorRef, due) : Debugger::BudgetUsed;
+        if (stop == Debugger::Faulted) {
+            result = debuggerRef.fault();
+        }
+        else if (stop != Debugger::BudgetUsed) {
+            publishFrame();
+            emit breakpointHit();
+            return false;
+        }
+    }
+    else if (emulatorRef.halted() || emulatorRef.waitingOnKeys()) {
+        //Nothing can change until a key does, so sleep until one does (or a frame has passed, to keep the capture going)
+        sleep = IDLE_INTERVAL;
+        idle = true;
+        due = 0;
+    }
+    else {
+        result = emulatorRef.runInstructions(due);
+    }
+    //A fault comes back as a status, the GUI thread only gets the message to show
+    if (!result.ok()) {
+        publishFrame();
+        emit faulted(QString::fromStdString(Chip8::faultMessage(result.fault, result.opcode)));
+        return false;
+    }
+    instructionsSincePaceStart += due;
+    frameInstructions += due;
+
+    //Run the once a frame work every 60th of a second, and publish the display often enough that the GUI always has a recent one
+    now = std::chrono::steady_clock::now();
+    if (now >= nextFrame) {
+        //A frame more than a whole frame late is not caught up on, the frames are timed again from now
+        nextFrame = (now - nextFrame >= FRAME_INTERVAL) ? now + FRAME_INTERVAL : nextFrame + FRAME_INTERVAL;
+        displayFrame();
+    }
+    if (now - lastPublish >= PUBLISH_INTERVAL) {
+        publishFrame(true);
+    }
+
+    //When running slower than flat out, sleep until the next instruction is due
+    if (speed > 0 && sleep == std::chrono::steady_clock::duration(0)) {
+        auto nextDue = paceStart + std::chrono::milliseconds(instructionsSincePaceStart * speed);
+        if (nextDue > now) {
+            sleep = nextDue - now;
+        }
+    }
+    if (sleep > std::chrono::steady_clock::duration(0)) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait_for(lock, sleep, [this]() { return !runRequested || quit || woken; });
+    }
+    if (idle) {
+        //Time the instructions after an idle spell from when it ended, rather than running them all at once to catch up
+        paceStart = std::chrono::steady_clock::now();
+        instructionsSincePaceStart = 0;
+    }
+    return true;
+}
+
+//Count the frame, look ahead and hand the capture the display, once every 60th of a second while running
+void EmulationThread::displayFrame()
+{
+    int ahead = runAheadFrames;
+    if (ahead > 0) {
+        int speed = cycleSpeed;
+        unsigned long long instructionsPerFrame = (speed > 0) ? 1000 / (60 * speed) : frameInstructions;
+        runAhead.lookAhead(emulatorRef, ahead, std::max<unsigned long long>(1, instructionsPerFrame));
+        std::copy(runAhead.video(), runAhead.video() + 32, aheadFrame.rows);
+    }
+    aheadReady = ahead > 0;
+    frameInstructions = 0;
+
+    ++emulatorRef.counters.frames;
+    if (captureRef.isRunning()) {
+        captureRef.submit(emulatorRef);
+    }
+}
+
+//Publish the emulator's display, or with run-ahead on and "lookAhead" set, the display the last look ahead reached
+void EmulationThread::publishFrame(bool lookAhead)
+{
+    if (lookAhead && aheadReady && runAheadFrames > 0) {
+        frames.back() = aheadFrame;
+    }
+    else {
+        pack(emulatorRef, frames.back());
+    }
+    frames.publish();
+    performanceTotals.back() = emulatorRef.performance();
+    performanceTotals.publish();
+    lastPublish = std::chrono::steady_clock::now();
+}
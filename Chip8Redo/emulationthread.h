@@ -0,0 +1,108 @@
+#ifndef EMULATIONTHREAD_H
+#define EMULATIONTHREAD_H
+
+#include <QObject>
+#include <QString>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "Chip8.h"
+#include "Debugger.h"
+#include "FrameCapture.h"
+#include "RunAhead.h"
+#include "TripleBuffer.h"
+
+//One packed display, a bit per pixel and a word per row with the leftmost pixel in the highest bit
+struct DisplayFrame
+{
+    unsigned long long rows[32];
+};
+
+/*
+Runs the emulator on its own thread so drawing, resizing and dialogs on the GUI thread never hold it up
+The thread executes instructions at the chosen speed and publishes the display into a triple buffer a few hundred times a second,
+the GUI takes only the most recent display whenever it redraws. The emulator's performance counters are published alongside it.
+With run-ahead on, the display published while running is the one a copy of the emulator reaches a few frames later. The copy is
+run once every 60th of a second, and a frame is a 60th of a second of instructions: a fixed number at the chosen speed, or running
+flat out however many ran in the last 60th of a second (so looking N frames ahead costs N times the emulation). Anything else that
+touches the emulator from the GUI thread (loading, stepping, reading registers) must pause() first, which returns once the thread
+has stopped using the emulator.
+*/
+class EmulationThread : public QObject
+{
+    Q_OBJECT
+
+public:
+    EmulationThread(Chip8 &emulator, Debugger &debugger, FrameCapture &capture, QObject *parent = nullptr);
+    ~EmulationThread();
+
+    //Start or continue executing instructions
+    void resume();
+    //Stop executing instructions, returns once the emulator is safe to use from the calling thread
+    void pause();
+    //Set how many milliseconds each instruction takes, 0 runs as fast as possible
+    void setCycleSpeed(int millisecondsPerInstruction);
+    //Check again straight away if the emulator was idling while it waited for a key
+    void wake();
+    //Show the display this many frames ahead of the emulator (see RunAhead.h), 0 turns run-ahead off
+    void setRunAhead(int frames) { runAheadFrames = std::max(0, frames); }
+
+    //Take the most recent display if a new one was published, returns false if front() is unchanged (GUI thread only)
+    bool takeFrame() { return frames.update(); }
+    const DisplayFrame &frame() const { return frames.front(); }
+    //Take the emulator's performance counters as they were when the most recent display was published (GUI thread only)
+    const PerformanceCounters::Totals &performance() { performanceTotals.update(); return performanceTotals.front(); }
+
+    //Pack the emulator's display into a frame
+    static void pack(const Chip8 &emulator, DisplayFrame &frame);
+
+signals:
+    //The thread stopped itself because the emulator threw an exception
+    void faulted(QString message);
+    //The thread stopped itself on a breakpoint or watchpoint
+    void breakpointHit();
+
+private:
+    //The loop the thread runs until destroyed
+    void run();
+    //Execute the instructions that are due, returns false if the thread stopped itself
+    bool runSlice();
+    //Everything done once per 60th of a second: count the frame, run the look ahead and hand the capture the display
+    void displayFrame();
+    void publishFrame(bool lookAhead = false);
+
+    Chip8 &emulatorRef;
+    Debugger &debuggerRef;
+    FrameCapture &captureRef;
+    TripleBuffer<DisplayFrame> frames;
+    TripleBuffer<PerformanceCounters::Totals> performanceTotals;
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool runRequested = false;//what the GUI asked for
+    bool parked = true;//true while the thread is not touching the emulator
+    bool quit = false;
+    std::atomic<bool> woken{false};
+
+    std::atomic<int> cycleSpeed{0};
+    std::atomic<int> runAheadFrames{0};
+    RunAhead runAhead;
+    DisplayFrame aheadFrame;//the display the last look ahead reached
+    bool aheadReady = false;//true if aheadFrame is from this run-ahead setting
+    unsigned long long frameInstructions = 0;//instructions run since the last frame began
+    std::chrono::steady_clock::time_point paceStart;//when the instruction count was last reset
+    unsigned long long instructionsSincePaceStart = 0;
+    std::chrono::steady_clock::time_point lastPublish;
+    std::chrono::steady_clock::time_point nextFrame;//when the next 60th of a second begins
+
+    static constexpr int SLICE_INSTRUCTIONS = 10000;//The most instructions executed between checks for pause requests
+    static constexpr std::chrono::milliseconds PUBLISH_INTERVAL{4};//How often the display is published (faster than any screen refreshes)
+    static constexpr std::chrono::microseconds FRAME_INTERVAL{16667};//One display frame, a 60th of a second
+    static constexpr std::chrono::milliseconds IDLE_INTERVAL{16};//How long an idle emulator sleeps before checking again
+};
+
+#endif // EMULATIONTHREAD_H
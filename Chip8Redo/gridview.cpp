@@ -0,0 +1,109 @@
+#include "gridview.h"
+#include <QPainter>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+GridView::GridView(const QStringList &roms, int instanceCount, QColor color, QWidget *parent)
+    : QWidget(parent), currentColor(color)
+{
+    setWindowTitle("CHIP-8 Grid View (" + QString::number(instanceCount) + " instances)");
+    setAttribute(Qt::WA_DeleteOnClose);
+
+    //Create every emulator, cycling through the ROMs and giving each instance its own random seed
+    for (int i = 0; i < instanceCount; i++) {
+        std::unique_ptr<Instance> instance(new Instance());
+        instance->emulator.reset(new Chip8());
+        instance->emulator->seedRandom(static_cast<unsigned int>(i + 1));
+        instance->emulator->soundEnabled = false;
+        for (std::atomic<unsigned long long> &row : instance->rows) {
+            row = 0u;
+        }
+        try {
+            QByteArray filename = roms[i % roms.size()].toUtf8();
+            instance->emulator->loadProgram(filename.constData());
+        } catch (std::exception &) {
+            instance->faulted = true;
+        }
+        instances.push_back(std::move(instance));
+    }
+
+    //Lay the displays out as close to a square as possible
+    columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(instanceCount)))));
+    int rows = (instanceCount + columns - 1) / columns;
+    atlas = QImage(columns * TILE_WIDTH, std::max(1, rows) * TILE_HEIGHT, QImage::Format_RGB32);
+    atlas.fill(Qt::darkGray);
+    resize(columns * TILE_WIDTH * 4, std::max(1, rows) * TILE_HEIGHT * 4);
+
+    //Start one worker per core (but never more workers than instances)
+    unsigned int workerCount = std::max(1u, std::min(std::thread::hardware_concurrency(), static_cast<unsigned int>(instanceCount)));
+    for (unsigned int worker = 0; worker < workerCount; worker++) {
+        workers.emplace_back(&GridView::runWorker, this, worker, workerCount);
+    }
+
+    timer = new QTimer(this);
+    connect(timer, &QTimer::timeout, this, &GridView::updateAtlas);
+    timer->start(16);
+}
+
+GridView::~GridView()
+{
+    running = false;
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+//Step this worker's share of the instances one frame at a time, publishing each display after its frame
+void GridView::runWorker(unsigned int worker, unsigned int workerCount)
+{
+    auto nextFrame = std::chrono::steady_clock::now();
+    while (running) {
+        for (size_t i = worker; i < instances.size(); i += workerCount) {
+            Instance &instance = *instances[i];
+            if (instance.faulted) {
+                continue;
+            }
+            if (!instance.emulator->runInstructions(INSTRUCTIONS_PER_FRAME).ok()) {
+                instance.faulted = true;
+            }
+            for (int y = 0; y < 32; y++) {
+                instance.rows[y].store(instance.emulator->video[y], std::memory_order_relaxed);
+            }
+        }
+        nextFrame += std::chrono::milliseconds(16);
+        std::this_thread::sleep_until(nextFrame);
+    }
+}
+
+//Copy every published display into its tile of the atlas, then schedule one repaint for the whole grid
+void GridView::updateAtlas()
+{
+    QRgb on = currentColor.rgb();
+    QRgb off = qRgb(0, 0, 0);
+    QRgb faulted = qRgb(96, 0, 0);//Instances that stopped with an error are shown with a red background
+
+    for (size_t i = 0; i < instances.size(); i++) {
+        const Instance &instance = *instances[i];
+        int left = static_cast<int>(i % columns) * TILE_WIDTH;
+        int top = static_cast<int>(i / columns) * TILE_HEIGHT;
+        QRgb background = instance.faulted ? faulted : off;
+
+        for (int y = 0; y < 32; y++) {
+            unsigned long long row = instance.rows[y].load(std::memory_order_relaxed);
+            QRgb *line = reinterpret_cast<QRgb *>(atlas.scanLine(top + y)) + left;
+            for (int x = 0; x < 64; x++) {
+                line[x] = ((row >> (63 - x)) & 1u) ? on : background;
+            }
+        }
+    }
+    update();
+}
+
+//Draw the atlas scaled to the window without smoothing so the pixels stay sharp
+void GridView::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter.drawImage(rect(), atlas);
+}
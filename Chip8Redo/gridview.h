@@ -0,0 +1,59 @@
+#ifndef GRIDVIEW_H
+#define GRIDVIEW_H
+
+#include <QWidget>
+#include <QImage>
+#include <QTimer>
+#include <QColor>
+#include <QStringList>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "Chip8.h"
+
+/*
+A window that runs many independent emulators at once and shows all of their displays as a grid
+The emulators are stepped by a small pool of worker threads, each one publishes its display as 32 packed rows,
+and once per display frame the GUI thread composites every display into a single atlas image and draws it in one call
+*/
+class GridView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    GridView(const QStringList &roms, int instances, QColor color, QWidget *parent = nullptr);
+    ~GridView();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private slots:
+    //Copy every published display into the atlas and repaint
+    void updateAtlas();
+
+private:
+    //One emulator in the grid and the last display it published
+    struct Instance
+    {
+        std::unique_ptr<Chip8> emulator;
+        std::atomic<unsigned long long> rows[32];
+        std::atomic<bool> faulted{false};
+    };
+
+    //The loop each worker thread runs, stepping every instance whose number matches the worker
+    void runWorker(unsigned int worker, unsigned int workerCount);
+
+    std::vector<std::unique_ptr<Instance>> instances;
+    std::vector<std::thread> workers;
+    std::atomic<bool> running{true};
+    QImage atlas;//Every display side by side, 64 x 32 pixels each with a 1 pixel border
+    QTimer *timer;//Updates the atlas once per display frame
+    QColor currentColor;//The color of lit pixels
+    int columns = 1;//How many displays are shown in each row of the grid
+    static constexpr int TILE_WIDTH = 65;
+    static constexpr int TILE_HEIGHT = 33;
+    static constexpr int INSTRUCTIONS_PER_FRAME = 100;//How many instructions each emulator runs every 16 milliseconds
+};
+
+#endif // GRIDVIEW_H
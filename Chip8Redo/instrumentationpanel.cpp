@@ -0,0 +1,86 @@
+#include "instrumentationpanel.h"
+#include <QPainter>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <algorithm>
+
+LatencyHistogram::LatencyHistogram(QWidget *parent)
+    : QWidget(parent), counts(InputLatency::BUCKETS, 0u)
+{
+    setMinimumSize(240, 120);
+}
+
+void LatencyHistogram::setCounts(const std::vector<unsigned long long> &bucketCounts)
+{
+    counts = bucketCounts;
+    update();
+}
+
+//Draw one bar per bucket scaled to the largest bucket, labelling the axis every few buckets
+void LatencyHistogram::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::black);
+
+    unsigned long long largest = std::max<unsigned long long>(1u, *std::max_element(counts.begin(), counts.end()));
+    int labelHeight = fontMetrics().height();
+    int plotHeight = height() - labelHeight;
+    double barWidth = static_cast<double>(width()) / counts.size();
+
+    for (size_t bucket = 0; bucket < counts.size(); bucket++) {
+        int barHeight = static_cast<int>(plotHeight * counts[bucket] / largest);
+        painter.fillRect(QRectF(bucket * barWidth + 1, plotHeight - barHeight, barWidth - 2, barHeight), Qt::green);
+    }
+
+    //Label roughly 1us, 1ms and 1s, where the buckets ending at 2^0, 2^10 and 2^20 microseconds end
+    painter.setPen(Qt::white);
+    const char *labels[] = {"1us", "1ms", "1s"};
+    for (int i = 0; i < 3; i++) {
+        painter.drawText(QPointF((i * 10 + 1) * barWidth, height() - 2), labels[i]);
+    }
+}
+
+InstrumentationPanel::InstrumentationPanel(InputLatency &latency, QWidget *parent)
+    : QDockWidget("Instrumentation", parent), latencyRef(latency)
+{
+    setObjectName("instrumentationPanel");
+    QWidget *contents = new QWidget(this);
+    QVBoxLayout *layout = new QVBoxLayout(contents);
+
+    layout->addWidget(new QLabel("Input latency (key event to the first instruction reading the keypad)", contents));
+    histogram = new LatencyHistogram(contents);
+    layout->addWidget(histogram, 1);
+    summaryLabel = new QLabel(contents);
+    layout->addWidget(summaryLabel);
+
+    QPushButton *resetButton = new QPushButton("Reset", contents);
+    layout->addWidget(resetButton);
+    connect(resetButton, &QPushButton::clicked, this, [this]() {
+        latencyRef.reset();
+        refresh();
+    });
+
+    setWidget(contents);
+
+    //Only spend time refreshing while the panel can be seen
+    timer = new QTimer(this);
+    connect(timer, &QTimer::timeout, this, &InstrumentationPanel::refresh);
+    connect(this, &QDockWidget::visibilityChanged, this, [this](bool visible) {
+        if (visible) {
+            refresh();
+            timer->start(REFRESH_INTERVAL);
+        }
+        else {
+            timer->stop();
+        }
+    });
+}
+
+void InstrumentationPanel::refresh()
+{
+    histogram->setCounts(latencyRef.histogram());
+    summaryLabel->setText(QString("%1 samples   median < %2 us   99th percentile < %3 us")
+                              .arg(latencyRef.samples())
+                              .arg(latencyRef.percentile(0.5))
+                              .arg(latencyRef.percentile(0.99)));
+}
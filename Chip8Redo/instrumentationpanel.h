@@ -0,0 +1,47 @@
+#ifndef INSTRUMENTATIONPANEL_H
+#define INSTRUMENTATIONPANEL_H
+
+#include <QDockWidget>
+#include <QLabel>
+#include <QTimer>
+#include <vector>
+#include "InputLatency.h"
+
+//Draws the input latency histogram as one bar per bucket
+class LatencyHistogram : public QWidget
+{
+public:
+    explicit LatencyHistogram(QWidget *parent = nullptr);
+    void setCounts(const std::vector<unsigned long long> &bucketCounts);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    std::vector<unsigned long long> counts;
+};
+
+/*
+A dockable panel showing measurements taken while the emulator runs
+It shows how long key events take to reach an instruction that reads the keypad, refreshed a few times a second while visible
+*/
+class InstrumentationPanel : public QDockWidget
+{
+    Q_OBJECT
+
+public:
+    InstrumentationPanel(InputLatency &latency, QWidget *parent = nullptr);
+
+private slots:
+    //Copy the latest measurements into the panel
+    void refresh();
+
+private:
+    InputLatency &latencyRef;
+    QLabel *summaryLabel;//Sample count and percentiles
+    LatencyHistogram *histogram;
+    QTimer *timer;//Refreshes the panel while it is visible
+    static constexpr int REFRESH_INTERVAL = 250;
+};
+
+#endif // INSTRUMENTATIONPANEL_H
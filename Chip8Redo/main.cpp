@@ -1,9 +1,16 @@
 #include "mainwindow.h"
 #include <QApplication>
 #include "Chip8.h"
+#include "Headless.h"
 
 int main(int argc, char *argv[])
 {
+    //Run A Command Line Tool Instead Of The Window If One Was Requested
+    int exitCode = 0;
+    if (runHeadless(argc, argv, exitCode)){
+        return exitCode;
+    }
+
     //Test Emulator Functions
     Chip8 myEmulator = Chip8();
 
@@ -4,6 +4,10 @@
 #include <QColor>
 #include <QInputDialog>
 #include <QFileDialog>
+#include <QScreen>
+#include <QActionGroup>
+#include <cstring>
+#include "gridview.h"
 
 MainWindow::MainWindow(Chip8& emulator, QWidget *parent)
     : QMainWindow(parent), ui(new Ui::MainWindow), emulatorRef(emulator)
@@ -13,25 +17,167 @@ MainWindow::MainWindow(Chip8& emulator, QWidget *parent)
     scene = new QGraphicsScene(this);//Setup the graphics scene
     scene->setBackgroundBrush(Qt::black);//Set the background of the graphics scene to black
     ui->graphicsView->setScene(scene);//Assign the grpahics scene to the graphics view
-    timer = new QTimer(this);//Setup a timer
-    connect(timer, &QTimer::timeout, this, &MainWindow::emulateCycle);//Connect the timer to the function "emulateCycle"
-    connect(this, &MainWindow::keyPressed, bindKeys, &BindKeys::handleKeyPress);
-    connect(this, &MainWindow::keyReleased, bindKeys, &BindKeys::handleKeyRelease);
+    displayItem = scene->addPixmap(QPixmap());//The display is drawn into this item once per screen refresh
+    setFilter(Upscaler::Nearest);
+
+    QMenu *filterMenu = ui->menuEmulation->addMenu("Filter");//Choose how the display is enlarged
+    QActionGroup *filterGroup = new QActionGroup(this);
+    for (Upscaler::Filter filter : {Upscaler::Nearest, Upscaler::Scale2x, Upscaler::Scale3x, Upscaler::HQ2x}) {
+        QAction *action = filterMenu->addAction(QString(Upscaler::name(filter)).toUpper(), this, [this, filter]() { setFilter(filter); });
+        action->setCheckable(true);
+        action->setChecked(filter == Upscaler::Nearest);
+        filterGroup->addAction(action);
+    }
+
+    QMenu *phosphorMenu = ui->menuEmulation->addMenu("Phosphor");//Choose how long pixels keep glowing after they go out
+    QActionGroup *phosphorGroup = new QActionGroup(this);
+    const QList<QPair<QString, int>> persistences = {{"Off", 0}, {"Short", 60}, {"Medium", 120}, {"Long", 250}};
+    for (const QPair<QString, int> &choice : persistences) {
+        int milliseconds = choice.second;
+        QAction *action = phosphorMenu->addAction(choice.first, this, [this, milliseconds]() { setPersistence(milliseconds); });
+        action->setCheckable(true);
+        action->setChecked(milliseconds == 0);
+        phosphorGroup->addAction(action);
+    }
+
+    QMenu *runAheadMenu = ui->menuEmulation->addMenu("Run-Ahead");//Show the display a few frames ahead to hide the program's input lag
+    QActionGroup *runAheadGroup = new QActionGroup(this);
+    for (int frames = 0; frames <= 4; frames++) {
+        QAction *action = runAheadMenu->addAction((frames == 0) ? QString("Off") : QString("%1 Frame%2").arg(frames).arg(frames > 1 ? "s" : ""), this, [this, frames]() { emulationThread->setRunAhead(frames); });
+        action->setCheckable(true);
+        action->setChecked(frames == 0);
+        runAheadGroup->addAction(action);
+    }
+
+    debugger.attach(emulatorRef);//Let the memory instructions report accesses to watched addresses
+    debuggerPanel = new DebuggerPanel(debugger, emulatorRef, this);//Setup the debugger panel, hidden until chosen from the Emulation menu
+    addDockWidget(Qt::RightDockWidgetArea, debuggerPanel);
+    debuggerPanel->hide();
+    ui->menuEmulation->addAction(debuggerPanel->toggleViewAction());
+    connect(debuggerPanel, &DebuggerPanel::continueRequested, this, [this]() { ui->Pause->setChecked(false); });
+    connect(debuggerPanel, &DebuggerPanel::breakRequested, this, &MainWindow::breakExecution);
+    connect(debuggerPanel, &DebuggerPanel::stepRequested, this, &MainWindow::debuggerStep);
+    connect(debuggerPanel, &DebuggerPanel::travelRequested, this, &MainWindow::debuggerTravel);
+
+    emulatorRef.inputLatency = &inputLatency;//Let the keypad instructions report when they see a key change
+    instrumentationPanel = new InstrumentationPanel(inputLatency, this);//Setup the instrumentation panel, hidden until chosen from the Emulation menu
+    addDockWidget(Qt::RightDockWidgetArea, instrumentationPanel);
+    instrumentationPanel->hide();
+    ui->menuEmulation->addAction(instrumentationPanel->toggleViewAction());
+
+    performanceOverlay = new PerformanceOverlay(ui->graphicsView);//Setup the performance overlay in the corner of the display
+    performanceOverlay->hide();
+    QAction *overlayAction = ui->menuEmulation->addAction("Performance Overlay");
+    overlayAction->setCheckable(true);
+    connect(overlayAction, &QAction::toggled, performanceOverlay, &PerformanceOverlay::setVisible);
+
+    emulationThread = new EmulationThread(emulatorRef, debugger, capture);//Instructions run on their own thread, parked until a ROM is loaded
+    connect(emulationThread, &EmulationThread::faulted, this, &MainWindow::emulationFaulted);
+    connect(emulationThread, &EmulationThread::breakpointHit, this, &MainWindow::breakExecution);
+    presentTimer = new QTimer(this);//Redraw once per screen refresh, drawing only the latest display however many were published
+    connect(presentTimer, &QTimer::timeout, this, &MainWindow::presentFrame);
+    qreal refreshRate = screen() ? screen()->refreshRate() : 60.0;
+    presentTimer->setTimerType(Qt::PreciseTimer);
+    presentTimer->start(qMax(1, qRound(1000.0 / (refreshRate > 0 ? refreshRate : 60.0))));
 }
 
 MainWindow::~MainWindow()
 {
+    delete emulationThread;//Stop the thread before the emulator, debugger and capture it uses are destroyed
     delete ui;
 }
-//This emits a signal with the key pressed and the Chip8 object to bindkeys class
+//This redraws the display if the emulation thread published a new one since the last redraw
+void MainWindow::presentFrame()
+{
+    if(emulationThread->takeFrame()) {
+        drawFrame(emulationThread->frame());
+    }
+    if(performanceOverlay->isVisible()) {
+        performanceOverlay->framePresented(presentTimer->interval());
+        performanceOverlay->setCounters(emulationThread->performance());
+    }
+}
+//This upscales a packed display with the chosen filter and shows it in the current color
+void MainWindow::drawFrame(const DisplayFrame &frame)
+{
+    shownFrame = frame;
+    const unsigned char *levels = upscaler.scale(frame.rows);
+    if (persistence > 0) {
+        levels = phosphor.blend(upscaler, frame.rows);
+    }
+    for (int y = 0; y < display.height(); ++y) {
+        std::memcpy(display.scanLine(y), levels + y * display.width(), display.width());
+    }
+    displayItem->setPixmap(QPixmap::fromImage(display));
+}
+//This switches the display filter, the filter's output is scaled to keep each CHIP-8 pixel PIXEL_SIZE wide on screen
+void MainWindow::setFilter(Upscaler::Filter filter)
+{
+    upscaler.setFilter(filter, PIXEL_SIZE);
+    display = QImage(upscaler.width(), upscaler.height(), QImage::Format_Indexed8);
+    updateColorTable();
+    displayItem->setScale(static_cast<qreal>(PIXEL_SIZE) / upscaler.factor());
+    phosphor.reset();
+    drawFrame(shownFrame);
+}
+//This turns the phosphor on with a fade out time, or off with 0
+void MainWindow::setPersistence(int milliseconds)
+{
+    persistence = milliseconds;
+    phosphor.setDecay(phosphorDecay(presentTimer->interval()));
+    updateColorTable();
+    drawFrame(shownFrame);
+}
+//How much brightness a pixel loses each frame, for frames this many milliseconds apart, to fade out in the persistence time
+int MainWindow::phosphorDecay(int frameMilliseconds) const
+{
+    if (persistence <= 0) {
+        return Phosphor::MAX_BRIGHTNESS;
+    }
+    return qMax(1, Phosphor::MAX_BRIGHTNESS * frameMilliseconds / persistence);
+}
+//This colors each level of the upscaled display (or each brightness, with the phosphor on), from black to currentColor
+void MainWindow::updateColorTable()
+{
+    int brightest = (persistence > 0) ? Phosphor::MAX_BRIGHTNESS : Upscaler::LIT;
+    QList<QRgb> colors;
+    for (int value = 0; value <= brightest; ++value) {
+        colors.append(qRgb(currentColor.red() * value / brightest, currentColor.green() * value / brightest, currentColor.blue() * value / brightest));
+    }
+    display.setColorTable(colors);
+}
+//This shows why the emulation thread stopped and closes the CHIP-8 program
+void MainWindow::emulationFaulted(QString message)
+{
+    errorDialog->showMessage(message);
+    on_actionClose_ROM_triggered();
+}
+//This presses the bound keypad key straight in the emulator and timestamps the event
 void MainWindow::keyPressEvent(QKeyEvent* event){
     QMainWindow::keyPressEvent(event);
-    emit keyPressed(static_cast<Qt::Key>(event->key()), emulatorRef);
+    int key = bindKeys->keypadIndex(event->key());
+    if (key >= 0 && !event->isAutoRepeat()) {
+        emulatorRef.keypad.press(key);
+        inputLatency.keyEvent();
+        wakeEmulation();
+    }
 }
-//This emits a signal with the key released and the Chip8 object to bindkeys class
+//This releases the bound keypad key straight in the emulator and timestamps the event
 void MainWindow::keyReleaseEvent(QKeyEvent* event) {
     QMainWindow::keyReleaseEvent(event);
-    emit keyReleased(static_cast<Qt::Key>(event->key()), emulatorRef);
+    int key = bindKeys->keypadIndex(event->key());
+    if (key >= 0 && !event->isAutoRepeat()) {
+        emulatorRef.keypad.release(key);
+        inputLatency.keyEvent();
+        wakeEmulation();
+    }
+}
+//This goes back to full speed straight away if the emulator was idling while it waited for a key
+void MainWindow::wakeEmulation()
+{
+    if(romLoaded && !paused) {
+        emulationThread->wake();
+    }
 }
 //This action opens a window with a "color picker" that allows the user to choose a color
 void MainWindow::on_actionColor_triggered()
@@ -39,6 +185,8 @@ void MainWindow::on_actionColor_triggered()
     QColor color = QColorDialog::getColor(Qt::white, this, "Choose Color");//open the color picker window and ask to choose a color
     if(color.isValid()) {//If color is valid, assign it to the currentColor variable
         currentColor = color;
+        updateColorTable();
+        drawFrame(shownFrame);//redraw now in case the emulator is paused and no new display is coming
     }
 }
 //This action creates a dialog box that allows the user to enter the processing speed they want the program to run at.
@@ -49,9 +197,7 @@ void MainWindow::on_actionSet_Speed_triggered()
 
     if(ok){//If ok is selected
         cycleSpeed = (millisecondsPerInstruction);//cycleSpeed is set to the value in millisecondsPerInstruction
-        if(romLoaded){//If a rom is loaded and the emulator is not paused
-            timer->start(cycleSpeed);//start the timer which executes the next instruction every "cycleSpeed" milliseconds
-        }
+        emulationThread->setCycleSpeed(cycleSpeed);//the emulation thread picks up the new speed straight away
     }
 
 }
@@ -67,11 +213,16 @@ void MainWindow::on_actionLoad_ROM_triggered()
             QByteArray filenameByteArray = filenamestr.toUtf8();
             const char* filename = filenameByteArray.constData();
 
+            emulationThread->pause();//The emulator can only be changed here once its thread has stopped using it
             emulatorRef.loadProgram(filename);
+            debugger.trace.clear();//Anything recorded was of the previous program
+            romLoaded = true;
+            if(performanceOverlay->isVisible()){
+                performanceOverlay->reset();
+            }
             if(!paused){
-                timer->start(cycleSpeed);
+                emulationThread->resume();
             }
-            romLoaded = true;
 
         }
     //If an Exception is thrown (file not valid, file to large) catch the resulting error and close the file
@@ -121,15 +272,17 @@ void MainWindow::on_Pause_toggled(bool arg1)
 {
     if(arg1) {//If pause button is toggled
         ui->Pause->setIconText("Play");
-        timer->stop();//Stops the timer so no new instructions can be executed
+        emulationThread->pause();//Stops the emulation thread so no new instructions can be executed
         paused = true;
+        drawFrame(packedDisplay());
+        debuggerPanel->refresh();
     }
     else {//If pause button is toggled again
         ui->Pause->setIconText("Pause");
+        paused = false;
         if(romLoaded){
-            timer->start(cycleSpeed);
+            emulationThread->resume();
         }
-        paused = false;
     }
 }
 
@@ -142,9 +295,118 @@ void MainWindow::on_actionChange_Keybinds_triggered()
 
 void MainWindow::on_actionClose_ROM_triggered()
 {
+    emulationThread->pause();
     emulatorRef.clearEmulator();
-    ui->graphicsView->scene()->clear();
-    timer->stop();
+    debugger.trace.clear();//Anything recorded was of the closed program
+    drawFrame(DisplayFrame{});
     romLoaded = false;
 }
 
+
+//This starts recording the display to a video file when Record is checked, and finishes the file when it is unchecked
+void MainWindow::on_action_Record_toggled(bool arg1)
+{
+    if(!arg1) {
+        emulationThread->pause();//Wait for the emulation thread to stop submitting frames before finishing the file
+        capture.stop();
+        if(romLoaded && !paused) {
+            emulationThread->resume();
+        }
+        return;
+    }
+
+    QString filenamestr = QFileDialog::getSaveFileName(this, "Record To", QString(), "Y4M Video (*.y4m);;Raw RGB24 Video (*.rgb)");
+    if(filenamestr.isEmpty()) {//If no file was chosen, uncheck Record again without starting a capture
+        ui->action_Record->setChecked(false);
+        return;
+    }
+
+    try{
+        FrameCapture::Format format = filenamestr.endsWith(".rgb", Qt::CaseInsensitive) ? FrameCapture::RawRGB : FrameCapture::Y4M;
+        emulationThread->pause();
+        capture.start(filenamestr.toStdString(), format, PIXEL_SIZE, currentColor.red(), currentColor.green(), currentColor.blue(), 60, upscaler.filter(), phosphorDecay(1000 / 60));
+    }catch(std::ios_base::failure error){
+        errorDialog->showMessage(error.what());
+        ui->action_Record->setChecked(false);
+    }
+    if(romLoaded && !paused) {
+        emulationThread->resume();
+    }
+}
+
+//This opens a window that runs many copies of the chosen ROMs at once and shows all of their displays together
+void MainWindow::on_actionGrid_View_triggered()
+{
+    QStringList roms = QFileDialog::getOpenFileNames(this, "Choose CHIP-8 ROMs For The Grid");
+    if(roms.isEmpty()) {
+        return;
+    }
+
+    bool ok;//Bool to check if ok is selected in the prompt on the next line
+    int instances = QInputDialog::getInt(this, tr("Grid View"), tr("Number of instances"), roms.size(), 1, 4096, 1, &ok);
+    if(ok) {
+        GridView *gridView = new GridView(roms, instances, currentColor);//The grid deletes itself when its window is closed
+        gridView->show();
+    }
+}
+
+//This pauses the emulator and shows where it stopped in the debugger panel
+void MainWindow::breakExecution()
+{
+    ui->Pause->setChecked(true);
+    debuggerPanel->show();
+    debuggerPanel->refresh();
+}
+
+//This runs one step chosen in the debugger panel, pausing first if the emulator was running
+void MainWindow::debuggerStep(DebuggerPanel::StepKind kind)
+{
+    if(!romLoaded) {
+        return;
+    }
+    ui->Pause->setChecked(true);
+
+    static constexpr unsigned long long STEP_BUDGET = 10000000;//Gives up on a step over or out that never returns
+    try{
+        Debugger::StopReason stop = Debugger::StepFinished;
+        switch(kind) {
+        case DebuggerPanel::StepInto:
+            stop = debugger.stepInto(emulatorRef);
+            break;
+        case DebuggerPanel::StepOver:
+            stop = debugger.stepOver(emulatorRef, STEP_BUDGET);
+            break;
+        case DebuggerPanel::StepOut:
+            stop = debugger.stepOut(emulatorRef, STEP_BUDGET);
+            break;
+        case DebuggerPanel::StepBack:
+            stop = debugger.stepBack(emulatorRef);
+            break;
+        case DebuggerPanel::ReverseContinue:
+            stop = debugger.reverseContinue(emulatorRef);
+            break;
+        }
+        if(stop == Debugger::Faulted) {//The emulator reports faults as a status, they only become exceptions here at the GUI
+            Chip8::raiseFault(debugger.fault().fault, debugger.fault().opcode);
+        }
+        drawFrame(packedDisplay());
+    }
+    //If an Exception Results Handle It
+    catch(std::exception &error){
+        errorDialog->showMessage(error.what());
+        on_actionClose_ROM_triggered();
+    }
+    debuggerPanel->refresh();
+}
+
+//This goes back to a cycle picked from the debugger panel's search of the recording
+void MainWindow::debuggerTravel(unsigned long long cycle)
+{
+    if(!romLoaded) {
+        return;
+    }
+    ui->Pause->setChecked(true);
+    debugger.travelTo(emulatorRef, cycle);//A cycle that is not recorded leaves the emulator where it was
+    drawFrame(packedDisplay());
+    debuggerPanel->refresh();
+}
@@ -4,9 +4,19 @@
 #include "bindkeys.h"
 #include <QMainWindow>
 #include "Chip8.h"
+#include "Debugger.h"
+#include "debuggerpanel.h"
+#include "InputLatency.h"
+#include "instrumentationpanel.h"
+#include "performanceoverlay.h"
+#include "FrameCapture.h"
+#include "emulationthread.h"
+#include "Phosphor.h"
+#include "Upscaler.h"
 #include "ui_mainwindow.h"
 #include <QGraphicsScene>
-#include <QGraphicsRectItem>
+#include <QGraphicsPixmapItem>
+#include <QImage>
 #include <QTimer>
 #include <QErrorMessage>
 #include <QMessageBox>
@@ -22,9 +32,6 @@ class MainWindow : public QMainWindow
 public:
     MainWindow(Chip8& emulator, QWidget *parent = nullptr);
     ~MainWindow();
-signals:
-    void keyPressed(Qt::Key key, Chip8& emulatorRef);
-    void keyReleased(Qt::Key key, Chip8& emulatorRef);
 private slots:
 
     void on_actionColor_triggered();
@@ -45,42 +52,24 @@ private slots:
 
     void on_actionClose_ROM_triggered();
 
-    //Attempt To Run The Next Instruction, If an Exception Results Display The Error Message and Close The CHIP-8 Program
-    void emulateCycle() {
-        try{
-            // Attempt To Execute one Chip-8 instruction per cycle
-            emulatorRef.nextInstruction();
-            // Update the graphics view
-            updateGraphics();
-        }
-        //If an Exception Results Handle It
-        catch(NullOperationException error){
-            errorDialog->showMessage(error.what());
-            on_actionClose_ROM_triggered();
-        }
-        catch(UnsupportedLanguageException error){
-            errorDialog->showMessage(error.what());
-            on_actionClose_ROM_triggered();
-        }
-        catch(std::out_of_range error){
-            errorDialog->showMessage(error.what());
-            on_actionClose_ROM_triggered();
-        }
-    }
-    //Update the GraphicsView scene based on the video array in the emulator
-    void updateGraphics(){
-        ui->graphicsView->scene()->clear();
-
-        for (int y = 0; y < 32; ++y) {
-            for (int x = 0; x < 64; ++x) {
-                if (emulatorRef.video[y][x] == 1) {//go through each array member in the video to determine if a pixel should be drawn
-                    QGraphicsRectItem* pixel = new QGraphicsRectItem(x * PIXEL_SIZE, y * PIXEL_SIZE, PIXEL_SIZE, PIXEL_SIZE);//If a pixel should be drawn, this draws it
-                    pixel->setBrush(QBrush(currentColor));//This determines the color the pixels will be drawn based on the variable "currentColor"
-                    ui->graphicsView->scene()->addItem(pixel);//Add the pixel to the graphics scene
-                }
-            }
-        }
-    }
+    void on_action_Record_toggled(bool arg1);
+
+    void on_actionGrid_View_triggered();
+
+    //Stop at the current instruction and show it in the debugger
+    void breakExecution();
+
+    //Run one step from the debugger panel while paused
+    void debuggerStep(DebuggerPanel::StepKind kind);
+
+    //Go back to a cycle found by searching the recording
+    void debuggerTravel(unsigned long long cycle);
+
+    //Show the emulation thread's error message and close the CHIP-8 program
+    void emulationFaulted(QString message);
+
+    //Draw the most recent display from the emulation thread, if it published a new one since the last redraw
+    void presentFrame();
 
 private:
     Ui::MainWindow *ui;
@@ -89,13 +78,33 @@ private:
     bool romLoaded = false;//Bool to determine if a rom has been loaded or not
     bool paused = false;//Bool to determine if the program is paused or not
     QGraphicsScene *scene;//The scene that will be assigned to the graphics view
-    QTimer *timer;//A timer for controlling how fast the instructions execute
+    QTimer *presentTimer;//A timer that redraws the display once per screen refresh
+    Upscaler upscaler;//Enlarges the display with the chosen filter before it is drawn
+    QImage display;//The upscaled display, one byte per pixel colored through its color table, reused for every redraw
+    Phosphor phosphor;//Keeps pixels glowing for a while after they go out, to hide sprite flicker
+    int persistence = 0;//How many milliseconds a pixel takes to fade out, 0 turns the phosphor off
+    DisplayFrame shownFrame{};//The display that was drawn last, so it can be drawn again when the color or filter changes
+    QGraphicsPixmapItem *displayItem;//The item that shows the display in the graphics scene
     QColor currentColor = Qt::white;//A Qcolor to determine the color of the drawn pixels onto the graphics scene
     int cycleSpeed = 0;//An int to determine how may milliseconds have to pass before an instruction can execute
     static constexpr int PIXEL_SIZE = 10;//Enlarges the drawn pixels so they aren't to small on the graphics scene
     QErrorMessage *errorDialog = new QErrorMessage();
+    FrameCapture capture;//Writes the display to a video file while Record is checked
+    Debugger debugger;//Breakpoints and stepping
+    DebuggerPanel *debuggerPanel;//The dockable view of the debugger
+    InputLatency inputLatency;//Times how long key events take to be read by the program
+    InstrumentationPanel *instrumentationPanel;//The dockable view of the input latency
+    PerformanceOverlay *performanceOverlay;//Shows how fast the emulator is really running over the display, hidden until chosen from the Emulation menu
+    EmulationThread *emulationThread;//Executes the instructions away from the GUI thread
+    void drawFrame(const DisplayFrame &frame);
+    void setFilter(Upscaler::Filter filter);
+    void setPersistence(int milliseconds);
+    int phosphorDecay(int frameMilliseconds) const;
+    void updateColorTable();
+    DisplayFrame packedDisplay() const { DisplayFrame frame; EmulationThread::pack(emulatorRef, frame); return frame; }//the emulator's display right now, only while its thread is paused
     void keyPressEvent(QKeyEvent* event);
     void keyReleaseEvent(QKeyEvent* event);
+    void wakeEmulation();
 };
 #endif // MAINWINDOW_H
 
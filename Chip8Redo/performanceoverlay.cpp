@@ -0,0 +1,111 @@
+#include "performanceoverlay.h"
+#include <algorithm>
+#include <cmath>
+
+PerformanceOverlay::PerformanceOverlay(QWidget *parent)
+    : QLabel(parent)
+{
+    setAttribute(Qt::WA_TransparentForMouseEvents);//Clicks go through to the display underneath
+    setStyleSheet("background-color: rgba(0, 0, 0, 160); color: white; font-family: monospace; padding: 4px;");
+    move(8, 8);
+
+    timer = new QTimer(this);
+    connect(timer, &QTimer::timeout, this, &PerformanceOverlay::refresh);
+}
+
+//Time the gap since the last redraw, and count the screen refreshes it missed if it came late
+void PerformanceOverlay::framePresented(int interval)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (lastPresent != std::chrono::steady_clock::time_point()) {
+        double milliseconds = std::chrono::duration<double, std::milli>(now - lastPresent).count();
+        if (frameTimes.size() < FRAME_SAMPLES) {
+            frameTimes.push_back(milliseconds);
+        }
+        else {
+            frameTimes[nextFrameTime] = milliseconds;
+            nextFrameTime = (nextFrameTime + 1) % FRAME_SAMPLES;
+        }
+        //A redraw more than half an interval late means at least one refresh went by without one
+        long long missed = std::llround(milliseconds / std::max(1, interval)) - 1;
+        if (missed > 0) {
+            droppedFrames += static_cast<unsigned long long>(missed);
+        }
+    }
+    lastPresent = now;
+}
+
+void PerformanceOverlay::reset()
+{
+    frameTimes.clear();
+    nextFrameTime = 0;
+    lastPresent = std::chrono::steady_clock::time_point();
+    droppedFrames = 0;
+    counters = PerformanceCounters::Totals();
+    refreshInstructions = 0;
+    lastRefresh = std::chrono::steady_clock::now();
+    instructionsPerSecond = 0.0;
+    refresh();
+}
+
+//Only spend time measuring and refreshing while the overlay can be seen, and start measuring afresh each time it is shown
+void PerformanceOverlay::showEvent(QShowEvent *event)
+{
+    QLabel::showEvent(event);
+    reset();
+    timer->start(REFRESH_INTERVAL);
+}
+
+void PerformanceOverlay::hideEvent(QHideEvent *event)
+{
+    QLabel::hideEvent(event);
+    timer->stop();
+}
+
+//The frame time that this fraction of the recent redraws came within
+double PerformanceOverlay::frameTimePercentile(double fraction) const
+{
+    if (frameTimes.empty()) {
+        return 0.0;
+    }
+    std::vector<double> sorted = frameTimes;
+    size_t rank = std::min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()));
+    std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+    return sorted[rank];
+}
+
+void PerformanceOverlay::refresh()
+{
+    auto now = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(now - lastRefresh).count();
+    //The counters start again from zero when a program is loaded, which is not a negative rate
+    if (counters.instructions < refreshInstructions) {
+        refreshInstructions = 0;
+    }
+    if (seconds > 0.0) {
+        instructionsPerSecond = (counters.instructions - refreshInstructions) / seconds;
+    }
+    refreshInstructions = counters.instructions;
+    lastRefresh = now;
+
+    setText(QString("%1 instructions/s\n"
+                    "frame time %2 / %3 / %4 ms (50/95/99%)\n"
+                    "dropped frames %5\n"
+                    "instructions %6   frames %7\n"
+                    "draws %8   pixels %9   collisions %10\n"
+                    "timer ticks %11   key wait %12   faults %13")
+                .arg(instructionsPerSecond, 0, 'f', 0)
+                .arg(frameTimePercentile(0.5), 0, 'f', 1)
+                .arg(frameTimePercentile(0.95), 0, 'f', 1)
+                .arg(frameTimePercentile(0.99), 0, 'f', 1)
+                .arg(droppedFrames)
+                .arg(counters.instructions)
+                .arg(counters.frames)
+                .arg(counters.draws)
+                .arg(counters.pixelsToggled)
+                .arg(counters.collisions)
+                .arg(counters.timerTicks)
+                .arg(counters.keyWaitCycles)
+                .arg(counters.faults));
+    adjustSize();
+}
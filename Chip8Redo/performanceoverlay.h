@@ -0,0 +1,54 @@
+#ifndef PERFORMANCEOVERLAY_H
+#define PERFORMANCEOVERLAY_H
+
+#include <QLabel>
+#include <QTimer>
+#include <chrono>
+#include <vector>
+#include "PerformanceCounters.h"
+
+/*
+A heads up display drawn over the emulator's display, showing how fast the emulator is really running
+It shows the instructions actually executed per second, percentiles of the time between redraws, how many screen refreshes were
+missed (dropped frames) and the emulator's performance counters. The window tells it about every redraw and hands it the latest
+counters, and it rewrites its text a couple of times a second while it is shown.
+*/
+class PerformanceOverlay : public QLabel
+{
+    Q_OBJECT
+
+public:
+    explicit PerformanceOverlay(QWidget *parent = nullptr);
+
+    //Note a redraw happening now, redraws are meant to be "interval" milliseconds apart
+    void framePresented(int interval);
+    //The emulator's counters as of the latest display
+    void setCounters(const PerformanceCounters::Totals &totals) { counters = totals; }
+    //Forget the measurements so far, for when a new program starts
+    void reset();
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    //Work out the rates and percentiles and rewrite the text
+    void refresh();
+
+private:
+    double frameTimePercentile(double fraction) const;
+
+    std::vector<double> frameTimes;//Milliseconds between the most recent redraws, FRAME_SAMPLES at most
+    size_t nextFrameTime = 0;//where the next one goes once frameTimes is full
+    std::chrono::steady_clock::time_point lastPresent;//the previous redraw, or the epoch if there was none yet
+    unsigned long long droppedFrames = 0;
+    PerformanceCounters::Totals counters;
+    unsigned long long refreshInstructions = 0;//counters.instructions at the previous refresh
+    std::chrono::steady_clock::time_point lastRefresh;
+    double instructionsPerSecond = 0.0;
+    QTimer *timer;//Rewrites the text while the overlay is shown
+    static constexpr int REFRESH_INTERVAL = 500;
+    static constexpr size_t FRAME_SAMPLES = 240;//about four seconds of redraws at 60Hz
+};
+
+#endif // PERFORMANCEOVERLAY_H